@@ -3,14 +3,267 @@
 
 #include <cstdint>
 #include <type_traits>
+#include <utility>
+#include <string.h>
 
 #include "utility.hpp"
 #include "hash.hpp"
+#include "array_layout.hpp"
+
+#if __has_include(<mdspan>)
+# include <array>
+# include <mdspan>
+#endif
 
 namespace ftl
 {
+    template <typename T, typename Layout, std::size_t... Dimensions>
+    class basic_array;
+
     template <typename T, std::size_t... Dimensions>
-    class array
+    using array = basic_array<T, row_major, Dimensions...>;
+
+    namespace detail {
+        // Base of the lazy element-wise expressions in array_ops.hpp
+        struct array_expression_base {};
+
+        template <typename Mapping>
+        constexpr std::size_t mapping_alignment() noexcept {
+            if constexpr(requires { Mapping::alignment; })
+                return Mapping::alignment;
+            else
+                return 0;
+        }
+
+        // Over-aligned storage is padded to a whole number of alignment
+        // sized blocks, when the element size divides the alignment
+        template <typename T, typename Mapping>
+        struct array_storage
+        {
+            constexpr static std::size_t alignment = mapping_alignment<Mapping>() > alignof(T) ? mapping_alignment<Mapping>() : alignof(T);
+            constexpr static std::size_t block = alignment % sizeof(T) == 0 ? alignment / sizeof(T) : 1;
+            constexpr static std::size_t size = (Mapping::storage_size + block - 1) / block * block;
+        };
+
+        // Expressions work on storage order, so the layout is part of the shape
+        template <typename Layout, std::size_t... Dimensions>
+        struct array_shape
+        {
+            constexpr static std::size_t size = (Dimensions * ...);
+
+            template <typename T>
+            using storage = array_storage<T, typename Layout::template mapping<Dimensions...>>;
+
+            template <typename T>
+            using array_type = ftl::basic_array<T, Layout, Dimensions...>;
+        };
+    }
+
+    template <typename E>
+    concept array_expression = std::is_base_of_v<detail::array_expression_base, E>;
+
+    template <typename T, typename Extents, typename Strides>
+    class strided_view;
+
+    namespace detail {
+        template <typename T, typename Extents, typename Strides>
+        struct strided_subview;
+
+        template <typename T, std::size_t E0, std::size_t... E, std::size_t S0, std::size_t... S>
+        struct strided_subview<T, extents<E0, E...>, extents<S0, S...>>
+        {
+            using type = strided_view<T, extents<E...>, extents<S...>>;
+        };
+    }
+
+    namespace detail {
+        // Arrays iterate in storage order, views in row-major order
+        template <typename Source>
+        constexpr bool iterates_row_major() noexcept {
+            if constexpr(requires { typename Source::mapping; }) {
+                if constexpr(Source::mapping::is_strided) {
+                    std::size_t stride = 1;
+                    for (std::size_t d = Source::dimension; d-- > 0;) {
+                        if (Source::mapping::strides::values[d] != stride)
+                            return false;
+                        stride *= Source::extent(d);
+                    }
+                    return true;
+                } else {
+                    return false;
+                }
+            } else {
+                return true;
+            }
+        }
+
+        template <typename Source, std::size_t... I>
+        constexpr decltype(auto) at_indices(const Source& source, const std::size_t* indices, std::index_sequence<I...>) {
+            return source.at(indices[I]...);
+        }
+    }
+
+    // Non-owning view of elements at fixed strides from an origin, with the
+    // extents and strides known at compile time.  Rows, columns and blocks of
+    // an ftl::array are views, so nothing is copied until asked for.
+    template <typename T, std::size_t... Extents, std::size_t... Strides>
+    class strided_view<T, extents<Extents...>, extents<Strides...>>
+    {
+        static_assert(sizeof...(Extents) == sizeof...(Strides), "a stride is needed for each extent");
+
+        public:
+            using value_type        = std::remove_cv_t<T>;
+            using element_type      = T;
+            using reference         = T&;
+            using pointer           = T*;
+            using size_type         = std::size_t;
+            using difference_type   = std::ptrdiff_t;
+
+            class iterator;
+
+            constexpr static size_type dimension = sizeof...(Extents);
+
+            constexpr explicit strided_view(pointer origin) noexcept : origin(origin) {}
+
+            template <typename U> requires (std::is_same_v<const U, T> && not std::is_same_v<U, T>)
+            constexpr strided_view(const strided_view<U, extents<Extents...>, extents<Strides...>>& other) noexcept
+                : origin(other.data()) {}
+
+            // element access, view[i] of a multi-dimensional view is a view
+            // of one less dimension
+            [[nodiscard]] constexpr reference operator[](size_type index) const noexcept requires (dimension == 1) {
+                return origin[index * stride(0)];
+            }
+
+            [[nodiscard]] constexpr auto operator[](size_type index) const noexcept requires (dimension > 1) {
+                using subview = typename detail::strided_subview<T, extents<Extents...>, extents<Strides...>>::type;
+                return subview(origin + index * stride(0));
+            }
+
+            template <typename... Index> requires (sizeof...(Index) == dimension)
+            [[nodiscard]] constexpr reference at(Index... index) const noexcept {
+                return origin[((static_cast<size_type>(index) * Strides) + ...)];
+            }
+
+            [[nodiscard]] constexpr pointer data() const noexcept { return origin; }
+
+            [[nodiscard]] constexpr iterator begin() const noexcept { return iterator(origin, 0); }
+            [[nodiscard]] constexpr iterator end() const noexcept { return iterator(origin, size()); }
+
+            // capacity
+            [[nodiscard]] constexpr static size_type size() noexcept { return (Extents * ...); }
+            [[nodiscard]] constexpr static size_type extent(size_type d) noexcept { return extent_list[d]; }
+            [[nodiscard]] constexpr static size_type stride(size_type d) noexcept { return stride_list[d]; }
+
+            // Calls f with every element in row-major order of the view, with
+            // a plain loop over the innermost extent
+            template <typename F>
+            constexpr void for_each(F&& f) const { visit<0>(origin, f); }
+
+            constexpr void fill(const value_type& value) const requires (not std::is_const_v<T>) {
+                for_each([&value](T& e) { e = value; });
+            }
+
+            // Copies the elements of an array or view of the same size, in
+            // row-major order of both, whatever the layout of an array source
+            template <typename Source> requires (not std::is_const_v<T>)
+            constexpr void copy_from(const Source& source) const {
+                static_assert(Source::size() == size(), "copying between different sizes");
+                if constexpr(detail::iterates_row_major<Source>()) {
+                    auto it = source.begin();
+                    for_each([&it](T& e) { e = *it; ++it; });
+                } else {
+                    size_type indices[Source::dimension] = {};
+                    for_each([&source, &indices](T& e) {
+                        e = detail::at_indices(source, indices, std::make_index_sequence<Source::dimension>{});
+                        for (size_type d = Source::dimension; d-- > 0;) {
+                            if (++indices[d] < Source::extent(d))
+                                break;
+                            indices[d] = 0;
+                        }
+                    });
+                }
+            }
+
+            [[nodiscard]] constexpr array<value_type, Extents...> to_array() const {
+                array<value_type, Extents...> result;
+                value_type* out = result.data();
+                for_each([&out](const T& e) { *out++ = e; });
+                return result;
+            }
+
+            #ifdef __cpp_lib_mdspan
+            [[nodiscard]] constexpr auto to_mdspan() const noexcept {
+                using mdspan_extents = std::extents<size_type, Extents...>;
+                return std::mdspan<T, mdspan_extents, std::layout_stride>(origin,
+                    std::layout_stride::mapping<mdspan_extents>(mdspan_extents{}, std::array<size_type, dimension>{ Strides... }));
+            }
+            #endif
+
+        private:
+            template <size_type D, typename F>
+            constexpr static void visit(pointer p, F& f) {
+                if constexpr(D + 1 == dimension) {
+                    for (size_type i = 0; i < extent(D); ++i)
+                        f(p[i * stride(D)]);
+                } else {
+                    for (size_type i = 0; i < extent(D); ++i)
+                        visit<D + 1>(p + i * stride(D), f);
+                }
+            }
+
+            constexpr static size_type extent_list[] = { Extents... };
+            constexpr static size_type stride_list[] = { Strides... };
+
+            pointer origin;
+    };
+
+    template <typename T, std::size_t... Extents, std::size_t... Strides>
+    class strided_view<T, extents<Extents...>, extents<Strides...>>::iterator
+    {
+        public:
+            using value_type        = std::remove_cv_t<T>;
+            using pointer           = T*;
+            using reference         = T&;
+            using difference_type   = std::ptrdiff_t;
+
+            constexpr iterator() noexcept = default;
+            constexpr iterator(pointer origin, size_type position) noexcept : ptr(origin), position(position) {}
+
+            constexpr reference operator*() const noexcept { return *ptr; }
+            constexpr pointer operator->() const noexcept { return ptr; }
+
+            constexpr iterator& operator++() noexcept {
+                ++position;
+                for (size_type d = dimension; d-- > 0;) {
+                    ptr += stride_list[d];
+                    if (++index[d] < extent_list[d] || d == 0)
+                        break;
+                    ptr -= stride_list[d] * extent_list[d];
+                    index[d] = 0;
+                }
+                return *this;
+            }
+
+            constexpr iterator operator++(int) noexcept {
+                iterator it = *this;
+                ++(*this);
+                return it;
+            }
+
+            constexpr bool operator==(const iterator& rhs) const noexcept { return position == rhs.position; }
+
+        private:
+            pointer ptr = nullptr;
+            size_type position = 0;
+            size_type index[dimension] = {};
+    };
+
+    // Fixed-size multi-dimensional array, Layout decides the order the
+    // elements are stored in.  Indexing works the same under every layout,
+    // iterators, data() and element-wise operations go in storage order.
+    template <typename T, typename Layout, std::size_t... Dimensions>
+    class basic_array
     {
         template <std::size_t Depth, bool IsConst>
         struct array_access_proxy;
@@ -26,20 +279,76 @@ namespace ftl
             using iterator          = T*;
             using const_iterator    = const T*;
 
+            using layout_type       = Layout;
+            using mapping           = typename Layout::template mapping<Dimensions...>;
+            using shape             = detail::array_shape<Layout, Dimensions...>;
+
             constexpr static std::size_t dimension = sizeof...(Dimensions);
+            constexpr static std::size_t alignment = detail::array_storage<T, mapping>::alignment;
 
-            constexpr array() noexcept = default;
+            constexpr basic_array() noexcept = default;
+
+            // Padding is kept initialised, element-wise operations read it
+            constexpr basic_array() noexcept requires (detail::array_storage<T, mapping>::size > mapping::storage_size) {
+                clear_padding();
+            }
 
             template <typename... Values>
-            explicit constexpr array(Values&&... v) noexcept : data_array{ FTL_FORWARD(v)... } {}
+                requires (not (sizeof...(Values) == 1 && ((array_expression<std::remove_cvref_t<Values>>
+                                                           || std::is_same_v<std::remove_cvref_t<Values>, basic_array>) && ...)))
+            explicit constexpr basic_array(Values&&... v) noexcept : data_array{ FTL_FORWARD(v)... } {}
+
+            // Evaluates an element-wise expression of the same shape in one pass
+            template <array_expression E>
+                requires std::is_same_v<typename E::shape, shape> && std::is_convertible_v<typename E::value_type, T>
+            constexpr basic_array(const E& expr) noexcept(noexcept(expr[0])) {
+                clear_padding();
+                assign_expression(expr);
+            }
+
+            template <array_expression E>
+                requires std::is_same_v<typename E::shape, shape> && std::is_convertible_v<typename E::value_type, T>
+            constexpr basic_array& operator=(const E& expr) noexcept(noexcept(expr[0])) {
+                assign_expression(expr);
+                return *this;
+            }
 
             // element access
             [[nodiscard]] constexpr auto operator[](size_type index) noexcept requires (dimension > 1) {
-                return array_access_proxy<1, false>(*this, index);
+                return array_access_proxy<1, false>(*this, { index });
+            }
+
+            [[nodiscard]] constexpr auto operator[](size_type index) const noexcept requires (dimension > 1) {
+                return array_access_proxy<1, true>(*this, { index });
             }
 
-            [[nodiscard]] constexpr const auto operator[](size_type index) const noexcept requires (dimension > 1) {
-                return array_access_proxy<1, true>(*this, index);
+            // a[i, j, k] where the compiler has multidimensional subscripts,
+            // a(i, j, k) everywhere; the same element as at(i, j, k), without
+            // a chain of proxies
+            #ifdef __cpp_multidimensional_subscript
+            template <typename... Index>
+                requires (sizeof...(Index) == dimension && dimension > 1 && (std::is_convertible_v<Index, size_type> && ...))
+            [[nodiscard]] constexpr reference operator[](Index... index) noexcept {
+                return data_array[offset_of(index...)];
+            }
+
+            template <typename... Index>
+                requires (sizeof...(Index) == dimension && dimension > 1 && (std::is_convertible_v<Index, size_type> && ...))
+            [[nodiscard]] constexpr const_reference operator[](Index... index) const noexcept {
+                return data_array[offset_of(index...)];
+            }
+            #endif
+
+            template <typename... Index>
+                requires (sizeof...(Index) == dimension && (std::is_convertible_v<Index, size_type> && ...))
+            [[nodiscard]] constexpr reference operator()(Index... index) noexcept {
+                return data_array[offset_of(index...)];
+            }
+
+            template <typename... Index>
+                requires (sizeof...(Index) == dimension && (std::is_convertible_v<Index, size_type> && ...))
+            [[nodiscard]] constexpr const_reference operator()(Index... index) const noexcept {
+                return data_array[offset_of(index...)];
             }
 
             [[nodiscard]] constexpr reference operator[](size_type index) noexcept requires (sizeof...(Dimensions) == 1) {
@@ -54,14 +363,14 @@ namespace ftl
             [[nodiscard]] constexpr reference at(Dims... d) noexcept requires (sizeof...(Dims) == sizeof...(Dimensions))
             {
                 static_assert(each_convertible_to<size_type, Dims...>());
-                return data_array[calc_array_index(d...)];
+                return data_array[offset_of(d...)];
             }
 
             template <typename... Dims>
             [[nodiscard]] constexpr const_reference at(Dims... d) const noexcept requires (sizeof...(Dims) == sizeof...(Dimensions))
             {
                 static_assert(each_convertible_to<size_type, Dims...>());
-                return data_array[calc_array_index(d...)];
+                return data_array[offset_of(d...)];
             }
 
             [[nodiscard]] constexpr reference front() noexcept                { return data_array[0]; }
@@ -77,42 +386,158 @@ namespace ftl
             [[nodiscard]] constexpr const_iterator begin() const noexcept { return iterator(data_array); }
             [[nodiscard]] constexpr const_iterator end() const noexcept { return iterator(data_array + size()); };
 
+            // views, for layouts where they are strided
+            [[nodiscard]] constexpr auto view() noexcept requires mapping::is_strided {
+                return strided_view<T, extents<Dimensions...>, typename mapping::strides>(data_array);
+            }
+            [[nodiscard]] constexpr auto view() const noexcept requires mapping::is_strided {
+                return strided_view<const T, extents<Dimensions...>, typename mapping::strides>(data_array);
+            }
+
+            [[nodiscard]] constexpr auto row(size_type r) noexcept requires (dimension == 2 && mapping::is_strided) {
+                return strided_view<T, extents<dim_size[1]>, extents<mapping::strides::values[1]>>(data_array + offset_of(r, 0));
+            }
+            [[nodiscard]] constexpr auto row(size_type r) const noexcept requires (dimension == 2 && mapping::is_strided) {
+                return strided_view<const T, extents<dim_size[1]>, extents<mapping::strides::values[1]>>(data_array + offset_of(r, 0));
+            }
+
+            [[nodiscard]] constexpr auto col(size_type c) noexcept requires (dimension == 2 && mapping::is_strided) {
+                return strided_view<T, extents<dim_size[0]>, extents<mapping::strides::values[0]>>(data_array + offset_of(0, c));
+            }
+            [[nodiscard]] constexpr auto col(size_type c) const noexcept requires (dimension == 2 && mapping::is_strided) {
+                return strided_view<const T, extents<dim_size[0]>, extents<mapping::strides::values[0]>>(data_array + offset_of(0, c));
+            }
+
+            // Sub-array of the given extents starting from the given indices
+            template <std::size_t... Extents, typename... Index>
+                requires (sizeof...(Extents) == dimension && sizeof...(Index) == dimension && mapping::is_strided)
+            [[nodiscard]] constexpr auto block(Index... start) noexcept {
+                return strided_view<T, extents<Extents...>, typename mapping::strides>(data_array + offset_of(start...));
+            }
+
+            template <std::size_t... Extents, typename... Index>
+                requires (sizeof...(Extents) == dimension && sizeof...(Index) == dimension && mapping::is_strided)
+            [[nodiscard]] constexpr auto block(Index... start) const noexcept {
+                return strided_view<const T, extents<Extents...>, typename mapping::strides>(data_array + offset_of(start...));
+            }
+
+            // Every Steps'th element along each dimension from the given
+            // indices, slice<extents<4, 4>, extents<2, 2>>(0, 0) is every
+            // other element of the top left 8x8 corner
+            template <typename Extents, typename Steps, typename... Index>
+                requires (sizeof...(Index) == dimension && mapping::is_strided)
+            [[nodiscard]] constexpr auto slice(Index... start) noexcept {
+                return make_slice<T, Extents, Steps>(data_array + offset_of(start...), std::make_index_sequence<dimension>{});
+            }
+
+            template <typename Extents, typename Steps, typename... Index>
+                requires (sizeof...(Index) == dimension && mapping::is_strided)
+            [[nodiscard]] constexpr auto slice(Index... start) const noexcept {
+                return make_slice<const T, Extents, Steps>(data_array + offset_of(start...), std::make_index_sequence<dimension>{});
+            }
+
+            #ifdef __cpp_lib_mdspan
+            [[nodiscard]] constexpr auto to_mdspan() noexcept requires mapping::is_strided { return make_mdspan<T>(data_array); }
+            [[nodiscard]] constexpr auto to_mdspan() const noexcept requires mapping::is_strided { return make_mdspan<const T>(data_array); }
+            #endif
+
             // capacity
             [[nodiscard]] constexpr static bool empty() noexcept { return size() == 0; }
             [[nodiscard]] constexpr static size_type size() noexcept { return (Dimensions * ...); }
             [[nodiscard]] constexpr static size_type max_size() noexcept { return (Dimensions * ...); }
+            [[nodiscard]] constexpr static size_type extent(size_type d) noexcept { return dim_size[d]; }
 
             [[nodiscard]] constexpr static size_type byte_size() noexcept { return size() * sizeof(T); }
+            // Elements in storage, more than size() with padding
+            [[nodiscard]] constexpr static size_type storage_size() noexcept { return detail::array_storage<T, mapping>::size; }
 
             // operations
             constexpr void fill(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>);
-            constexpr void swap(array& other) noexcept(std::is_nothrow_swappable_v<T>);
+            constexpr void swap(basic_array& other) noexcept(std::is_nothrow_swappable_v<T>);
 
             [[nodiscard]] constexpr uint64_t hash() const noexcept { return ::ftl::hash(*this); }
 
         private:
-            template <typename... Dims>
-            constexpr static size_type calc_array_index(size_type idx, Dims... d) noexcept
-            {
-                if constexpr(sizeof...(Dims))
-                    return idx * dim_size[sizeof...(d)] + calc_array_index(d...);
-                return idx;
+            // Elements only depend on the same index of the operands, so
+            // the expression may read this array while it is written
+            //
+            // Floating point arrays go over the padding as well when every
+            // operand has at least as much of it and the expression keeps
+            // it zero without raising exceptions, so the loop is whole
+            // aligned vectors
+            template <typename E>
+            constexpr void assign_expression(const E& expr) noexcept(noexcept(expr[0])) {
+                if (std::is_constant_evaluated()) {
+                    for (size_type i = 0; i < size(); ++i)
+                        data_array[i] = expr[i];
+                } else {
+                    constexpr size_type count = std::is_floating_point_v<T> && E::padded_size > size()
+                                              ? (E::padded_size < storage_size() ? E::padded_size : storage_size())
+                                              : size();
+
+                    pointer target = static_cast<pointer>(__builtin_assume_aligned(data_array, alignment));
+                    FTL_VECTORISE
+                    for (size_type i = 0; i < count; ++i)
+                        target[i] = expr[i];
+                }
+            }
+
+            constexpr void clear_padding() noexcept {
+                for (size_type i = mapping::storage_size; i < storage_size(); ++i)
+                    data_array[i] = T();
+            }
+
+            template <typename... Index>
+            constexpr static size_type offset_of(Index... index) noexcept {
+                const size_type indices[] = { static_cast<size_type>(index)... };
+                return mapping::offset(indices);
+            }
+
+            template <typename U, typename Extents, typename Steps, std::size_t... I>
+            constexpr static auto make_slice(U* origin, std::index_sequence<I...>) noexcept {
+                static_assert(Extents::rank == dimension && Steps::rank == dimension);
+                return strided_view<U, Extents, extents<(mapping::strides::values[I] * Steps::values[I])...>>(origin);
+            }
+
+            #ifdef __cpp_lib_mdspan
+            template <typename U>
+            constexpr static auto make_mdspan(U* origin) noexcept {
+                using mdspan_extents = std::extents<size_type, Dimensions...>;
+                if constexpr(std::is_same_v<Layout, row_major>)
+                    return std::mdspan<U, mdspan_extents, std::layout_right>(origin);
+                else if constexpr(std::is_same_v<Layout, column_major>)
+                    return std::mdspan<U, mdspan_extents, std::layout_left>(origin);
+                else {
+                    std::array<size_type, dimension> stride_list;
+                    for (size_type d = 0; d < dimension; ++d)
+                        stride_list[d] = mapping::strides::values[d];
+                    return std::mdspan<U, mdspan_extents, std::layout_stride>(origin,
+                        std::layout_stride::mapping<mdspan_extents>(mdspan_extents{}, stride_list));
+                }
             }
+            #endif
 
             constexpr static size_type dim_size[] = { Dimensions... };
-            value_type data_array[size()];
+            alignas(alignment) value_type data_array[detail::array_storage<T, mapping>::size];
     };
 
-    template <typename T, std::size_t... Dimensions>
-    void swap(array<T, Dimensions...>& a, array<T, Dimensions...>& b) noexcept(std::is_nothrow_swappable_v<T>) {
+    template <typename T, typename Layout, std::size_t... Dimensions>
+    void swap(basic_array<T, Layout, Dimensions...>& a, basic_array<T, Layout, Dimensions...>& b) noexcept(std::is_nothrow_swappable_v<T>) {
         auto temp = FTL_MOVE(a);
         a = FTL_MOVE(b);
         b = FTL_MOVE(temp);
     }
 
-    template <typename T, std::size_t... Dimensions>
-    constexpr bool operator==(const array<T, Dimensions...>& lhs, const array<T, Dimensions...>& rhs) noexcept
+    template <typename T, typename Layout, std::size_t... Dimensions>
+    constexpr bool operator==(const basic_array<T, Layout, Dimensions...>& lhs, const basic_array<T, Layout, Dimensions...>& rhs) noexcept
     {
+        // equal values have equal bytes for these, which floats, for one,
+        // do not have
+        if constexpr(std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>) {
+            if (not std::is_constant_evaluated())
+                return memcmp(static_cast<const void*>(lhs.data()), static_cast<const void*>(rhs.data()), lhs.byte_size()) == 0;
+        }
+
         auto lhs_it = lhs.begin();
         auto rhs_it = rhs.begin();
 
@@ -123,44 +548,73 @@ namespace ftl
         return true;
     }
 
-    template <typename T, std::size_t... Dimensions>
+    // Collects one index per [], the element is looked up from the layout
+    // once all of them are known
+    template <typename T, typename Layout, std::size_t... Dimensions>
     template <std::size_t Depth, bool IsConst>
-    struct array<T, Dimensions...>::array_access_proxy
+    struct basic_array<T, Layout, Dimensions...>::array_access_proxy
     {
-        using ref_type = typename std::conditional<IsConst, const array&, array&>::type;
+        using ref_type = typename std::conditional<IsConst, const basic_array&, basic_array&>::type;
 
         ref_type        ref;
-        size_type       cindex;
-
-        constexpr explicit array_access_proxy(array& arr, std::size_t cindex) noexcept requires (!IsConst) : ref(arr), cindex(cindex) {}
-        constexpr explicit array_access_proxy(const array& arr, std::size_t cindex) noexcept requires (IsConst): ref(arr), cindex(cindex) {}
+        size_type       indices[Depth];
 
-        constexpr reference operator[](std::size_t index) && noexcept 
-            requires (!IsConst) && (Depth + 1 == array::dimension)
-        {
-            return ref.data_array[cindex * ref.dim_size[Depth - 1] + index];
+        constexpr array_access_proxy(ref_type arr, const size_type (&prefix)[Depth]) noexcept : ref(arr) {
+            for (std::size_t d = 0; d < Depth; ++d)
+                indices[d] = prefix[d];
         }
 
-        constexpr const_reference operator[](std::size_t index) const && noexcept
-            requires (Depth + 1 == array::dimension) && IsConst
-        {
-            return ref.data_array[cindex * ref.dim_size[Depth - 1] + index];
+        // The proxy only refers to the array, so it can be indexed as an
+        // lvalue or an rvalue, const or not
+        constexpr decltype(auto) operator[](std::size_t index) const noexcept requires (Depth + 1 == basic_array::dimension) {
+            return ref.data_array[element_offset(index)];
         }
 
-        constexpr auto operator[](std::size_t index) const && noexcept requires (Depth + 1 < sizeof...(Dimensions)) {
-            return array_access_proxy<Depth+1, IsConst>(ref, index + (cindex * ref.dim_size[Depth-1]));
+        constexpr auto operator[](std::size_t index) const noexcept requires (Depth + 1 < sizeof...(Dimensions)) {
+            size_type next[Depth + 1];
+            for (std::size_t d = 0; d < Depth; ++d)
+                next[d] = indices[d];
+            next[Depth] = index;
+            return array_access_proxy<Depth+1, IsConst>(ref, next);
         }
+
+        private:
+            constexpr size_type element_offset(std::size_t index) const noexcept {
+                size_type all[Depth + 1];
+                for (std::size_t d = 0; d < Depth; ++d)
+                    all[d] = indices[d];
+                all[Depth] = index;
+                return mapping::offset(all);
+            }
     };
 
-    template <typename T, std::size_t... Dimensions>
-    constexpr void array<T, Dimensions...>::fill(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>)
+    template <typename T, typename Layout, std::size_t... Dimensions>
+    constexpr void basic_array<T, Layout, Dimensions...>::fill(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>)
     {
+        // memset when all bytes of the value are the same, like for zero,
+        // the loop vectorises well enough otherwise
+        if constexpr(std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>) {
+            if (not std::is_constant_evaluated()) {
+                unsigned char bytes[sizeof(T)];
+                memcpy(static_cast<void*>(bytes), static_cast<const void*>(&value), sizeof(T));
+
+                bool uniform = true;
+                for (std::size_t i = 1; i < sizeof(T); ++i)
+                    uniform = uniform && bytes[i] == bytes[0];
+
+                if (uniform) {
+                    memset(static_cast<void*>(data_array), bytes[0], sizeof(data_array));
+                    return;
+                }
+            }
+        }
+
         for (T& e : data_array)
             e = value;
     }
 
-    template <typename T, std::size_t... Dimensions>
-    constexpr void array<T, Dimensions...>::swap(array& other) noexcept(std::is_nothrow_swappable_v<T>)
+    template <typename T, typename Layout, std::size_t... Dimensions>
+    constexpr void basic_array<T, Layout, Dimensions...>::swap(basic_array& other) noexcept(std::is_nothrow_swappable_v<T>)
     {
         ::ftl::swap(*this, other);
     }
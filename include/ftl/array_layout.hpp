@@ -0,0 +1,214 @@
+#ifndef FTL_ARRAY_LAYOUT_HPP
+#define FTL_ARRAY_LAYOUT_HPP
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace ftl
+{
+    // Compile-time list of extents or strides
+    template <std::size_t... Values>
+    struct extents
+    {
+        static_assert(sizeof...(Values) > 0);
+
+        constexpr static std::size_t rank = sizeof...(Values);
+        constexpr static std::size_t values[] = { Values... };
+    };
+
+    // Layouts decide where element (i, j, ...) of an ftl::array is stored.
+    //
+    // A layout has a member template mapping<Dimensions...> with
+    //      constexpr static std::size_t storage_size
+    //      constexpr static bool is_strided
+    //      constexpr static std::size_t offset(const std::size_t* indices)
+    // and, if is_strided, a strides type that is an ftl::extents.  Strided
+    // layouts can have row, column and block views.  A mapping may also have
+    //      constexpr static std::size_t alignment
+    // for the start of the storage.
+
+    namespace detail {
+        template <std::size_t... Dimensions>
+        constexpr std::size_t row_major_stride(std::size_t index) noexcept {
+            constexpr std::size_t dims[] = { Dimensions... };
+            std::size_t stride = 1;
+            for (std::size_t d = index + 1; d < sizeof...(Dimensions); ++d)
+                stride *= dims[d];
+            return stride;
+        }
+
+        template <std::size_t... Dimensions>
+        constexpr std::size_t column_major_stride(std::size_t index) noexcept {
+            constexpr std::size_t dims[] = { Dimensions... };
+            std::size_t stride = 1;
+            for (std::size_t d = 0; d < index; ++d)
+                stride *= dims[d];
+            return stride;
+        }
+
+        template <typename Sequence, std::size_t... Dimensions>
+        struct layout_strides;
+
+        template <std::size_t... I, std::size_t... Dimensions>
+        struct layout_strides<std::index_sequence<I...>, Dimensions...>
+        {
+            using row_major = extents<row_major_stride<Dimensions...>(I)...>;
+            using column_major = extents<column_major_stride<Dimensions...>(I)...>;
+        };
+
+        template <typename Strides, std::size_t... Dimensions>
+        struct strided_mapping
+        {
+            constexpr static std::size_t storage_size = (Dimensions * ...);
+            constexpr static bool is_strided = true;
+
+            using strides = Strides;
+
+            constexpr static std::size_t offset(const std::size_t* indices) noexcept {
+                std::size_t result = 0;
+                for (std::size_t d = 0; d < sizeof...(Dimensions); ++d)
+                    result += indices[d] * strides::values[d];
+                return result;
+            }
+        };
+
+        constexpr bool is_power_of_two(std::size_t value) noexcept {
+            return value != 0 && (value & (value - 1)) == 0;
+        }
+
+        template <typename... Values>
+        constexpr std::size_t max_of(Values... values) noexcept {
+            std::size_t result = 0;
+            ((result = values > result ? values : result), ...);
+            return result;
+        }
+
+        constexpr std::size_t log2(std::size_t value) noexcept {
+            std::size_t bits = 0;
+            while (value > 1) {
+                value >>= 1;
+                ++bits;
+            }
+            return bits;
+        }
+    }
+
+    // Last index is contiguous, like C arrays
+    struct row_major
+    {
+        template <std::size_t... Dimensions>
+        using mapping = detail::strided_mapping<
+            typename detail::layout_strides<std::make_index_sequence<sizeof...(Dimensions)>, Dimensions...>::row_major,
+            Dimensions...>;
+    };
+
+    // First index is contiguous, like Fortran arrays
+    struct column_major
+    {
+        template <std::size_t... Dimensions>
+        using mapping = detail::strided_mapping<
+            typename detail::layout_strides<std::make_index_sequence<sizeof...(Dimensions)>, Dimensions...>::column_major,
+            Dimensions...>;
+    };
+
+    // Row-major tiles of TileExtents..., each stored row-major and
+    // contiguously, so that a neighbourhood is in a few cache lines instead
+    // of one line per row.  The dimensions have to be multiples of the tile.
+    template <std::size_t... TileExtents>
+    struct tiled
+    {
+        template <std::size_t... Dimensions>
+        struct mapping
+        {
+            static_assert(sizeof...(TileExtents) == sizeof...(Dimensions), "tile needs an extent for each dimension");
+            static_assert(((Dimensions % TileExtents == 0) && ...), "dimensions must be multiples of the tile extents");
+
+            constexpr static std::size_t storage_size = (Dimensions * ...);
+            constexpr static bool is_strided = false;
+
+            constexpr static std::size_t offset(const std::size_t* indices) noexcept {
+                constexpr std::size_t dims[] = { Dimensions... };
+                constexpr std::size_t tile[] = { TileExtents... };
+                constexpr std::size_t tile_size = (TileExtents * ...);
+
+                std::size_t tile_index = 0;
+                std::size_t inner_index = 0;
+                for (std::size_t d = 0; d < sizeof...(Dimensions); ++d) {
+                    tile_index = tile_index * (dims[d] / tile[d]) + indices[d] / tile[d];
+                    inner_index = inner_index * tile[d] + indices[d] % tile[d];
+                }
+                return tile_index * tile_size + inner_index;
+            }
+        };
+    };
+
+    // Layout with its storage aligned to Alignment bytes and padded to a
+    // whole multiple of it, e.g. 32 for AVX or 64 for AVX-512 and cache
+    // lines.  Element-wise operations on floating point arrays use aligned
+    // loads over the padded storage, so they need no scalar tail loop.
+    template <std::size_t Alignment, typename Layout = row_major>
+    struct aligned
+    {
+        static_assert(detail::is_power_of_two(Alignment), "Alignment must be a power of two");
+
+        template <std::size_t... Dimensions>
+        struct mapping : Layout::template mapping<Dimensions...>
+        {
+            constexpr static std::size_t alignment = Alignment;
+        };
+    };
+
+    // Z-order curve, bits of the indices interleaved with the last index in
+    // the lowest bit, so that nearby elements in every direction tend to be
+    // nearby in memory.  The dimensions have to be powers of two; a longer
+    // dimension continues with its own bits once the shorter ones run out.
+    struct morton
+    {
+        template <std::size_t... Dimensions>
+        struct mapping
+        {
+            static_assert((detail::is_power_of_two(Dimensions) && ...), "morton layout needs power-of-two dimensions");
+
+            constexpr static std::size_t storage_size = (Dimensions * ...);
+            constexpr static bool is_strided = false;
+
+            constexpr static std::size_t offset(const std::size_t* indices) noexcept {
+                constexpr std::size_t rank = sizeof...(Dimensions);
+                constexpr std::size_t bits[] = { detail::log2(Dimensions)... };
+                constexpr std::size_t max_bits = detail::max_of(detail::log2(Dimensions)...);
+
+                std::size_t result = 0;
+                std::size_t position = 0;
+                for (std::size_t bit = 0; bit < max_bits; ++bit) {
+                    for (std::size_t d = rank; d-- > 0;) {
+                        if (bit < bits[d])
+                            result |= ((indices[d] >> bit) & 1) << position++;
+                    }
+                }
+                return result;
+            }
+        };
+    };
+}
+
+#endif
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
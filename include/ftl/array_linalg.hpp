@@ -0,0 +1,109 @@
+#ifndef FTL_ARRAY_LINALG_HPP
+#define FTL_ARRAY_LINALG_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+#include "utility.hpp"
+#include "array.hpp"
+
+namespace ftl
+{
+    namespace detail {
+        // Columns of the result summed at once
+        template <std::size_t N>
+        constexpr std::size_t matmul_row_block = N < 64 ? N : 64;
+
+        // Width columns of the result from col_begin, the width is a constant
+        // so that the row segment being summed into stays in registers or L1
+        template <std::size_t M, std::size_t K, std::size_t Width, typename A, typename B, typename Result>
+        constexpr void matmul_columns(const A& a, const B& b, Result& result, std::size_t col_begin) {
+            using result_type = typename Result::value_type;
+
+            for (std::size_t i = 0; i < M; ++i) {
+                for (std::size_t j = 0; j < Width; ++j)
+                    result.at(i, col_begin + j) = result_type();
+
+                for (std::size_t k = 0; k < K; ++k) {
+                    const result_type scale = a.at(i, k);
+                    for (std::size_t j = 0; j < Width; ++j)
+                        result.at(i, col_begin + j) += scale * b.at(k, col_begin + j);
+                }
+            }
+        }
+
+        // Tiles below this size are transposed directly, two tiles of it stay
+        // in L1 for any element size up to double
+        constexpr std::size_t transpose_tile = 16;
+
+        template <typename Source, typename Target>
+        constexpr void transpose_tiles(const Source& source, Target& target,
+                                       std::size_t row_begin, std::size_t row_end,
+                                       std::size_t col_begin, std::size_t col_end) {
+            const std::size_t rows = row_end - row_begin;
+            const std::size_t cols = col_end - col_begin;
+
+            if (rows <= transpose_tile && cols <= transpose_tile) {
+                for (std::size_t r = row_begin; r < row_end; ++r)
+                    for (std::size_t c = col_begin; c < col_end; ++c)
+                        target.at(c, r) = source.at(r, c);
+            } else if (rows >= cols) {
+                const std::size_t middle = row_begin + rows / 2;
+                transpose_tiles(source, target, row_begin, middle, col_begin, col_end);
+                transpose_tiles(source, target, middle, row_end, col_begin, col_end);
+            } else {
+                const std::size_t middle = col_begin + cols / 2;
+                transpose_tiles(source, target, row_begin, row_end, col_begin, middle);
+                transpose_tiles(source, target, row_begin, row_end, middle, col_end);
+            }
+        }
+    }
+
+    // Matrix product of M x K and K x N arrays.  Rows of the result are
+    // summed in blocks of at most 64 columns, so the block of b in use stays
+    // in cache; the inner loop runs over contiguous columns of b and the
+    // result and vectorises for float and double.
+    template <typename T, typename U, typename LayoutA, typename LayoutB, std::size_t M, std::size_t K, std::size_t N>
+    [[nodiscard]] constexpr auto matmul(const basic_array<T, LayoutA, M, K>& a, const basic_array<U, LayoutB, K, N>& b) {
+        using result_type = std::remove_cvref_t<decltype(a.at(0, 0) * b.at(0, 0))>;
+        constexpr std::size_t block = detail::matmul_row_block<N>;
+        constexpr std::size_t tail = N % block;
+
+        array<result_type, M, N> result;
+        for (std::size_t col_begin = 0; col_begin + block <= N; col_begin += block)
+            detail::matmul_columns<M, K, block>(a, b, result, col_begin);
+        if constexpr(tail != 0)
+            detail::matmul_columns<M, K, tail>(a, b, result, N - tail);
+        return result;
+    }
+
+    // R x C array to C x R.  Large arrays are split recursively into halves
+    // until the tiles fit in cache, whatever the cache sizes are.
+    template <typename T, typename Layout, std::size_t R, std::size_t C>
+    [[nodiscard]] constexpr basic_array<T, Layout, C, R> transpose(const basic_array<T, Layout, R, C>& source) {
+        basic_array<T, Layout, C, R> result;
+        detail::transpose_tiles(source, result, 0, R, 0, C);
+        return result;
+    }
+}
+
+#endif
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
@@ -0,0 +1,562 @@
+#ifndef FTL_ARRAY_OPS_HPP
+#define FTL_ARRAY_OPS_HPP
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "utility.hpp"
+#include "array.hpp"
+
+namespace ftl
+{
+    namespace detail {
+        template <typename T>
+        struct is_ftl_array : std::false_type {};
+
+        template <typename T, typename Layout, std::size_t... Dimensions>
+        struct is_ftl_array<basic_array<T, Layout, Dimensions...>> : std::true_type {};
+
+        // Operands are arrays, which are referred to if they are lvalues and
+        // held by value if they are temporaries, expressions, held by value,
+        // and scalars, broadcast to every element.
+        //
+        // padded_size is how many elements may be read, including the
+        // zero padding of over-aligned floating point arrays.  Scalars would
+        // make the padding nonzero, or raise on it as in 0 * inf, so they
+        // keep an expression out of the padding.
+        template <typename T, typename Shape>
+        constexpr std::size_t leaf_padded_size = std::is_floating_point_v<T> ? Shape::template storage<T>::size : Shape::size;
+
+        template <typename T, typename Shape>
+        constexpr const T* assume_array_aligned(const T* ptr) noexcept {
+            if (std::is_constant_evaluated())
+                return ptr;
+            return static_cast<const T*>(__builtin_assume_aligned(ptr, Shape::template storage<T>::alignment));
+        }
+
+        template <typename T, typename Shape>
+        struct array_ref_leaf
+        {
+            using value_type    = T;
+            using shape         = Shape;
+
+            constexpr static std::size_t padded_size = leaf_padded_size<T, Shape>;
+
+            const T* ptr;
+
+            constexpr const T& operator[](std::size_t index) const noexcept { return assume_array_aligned<T, Shape>(ptr)[index]; }
+        };
+
+        template <typename Array>
+        struct array_value_leaf
+        {
+            using value_type    = typename Array::value_type;
+            using shape         = typename Array::shape;
+
+            constexpr static std::size_t padded_size = leaf_padded_size<value_type, shape>;
+
+            Array value;
+
+            constexpr const value_type& operator[](std::size_t index) const noexcept {
+                return assume_array_aligned<value_type, shape>(value.data())[index];
+            }
+        };
+
+        template <typename T>
+        struct scalar_leaf
+        {
+            using value_type    = T;
+            using shape         = void;
+
+            constexpr static std::size_t padded_size = 0;
+
+            T value;
+
+            constexpr const T& operator[](std::size_t) const noexcept { return value; }
+        };
+
+        template <typename T>
+        constexpr auto as_operand(T&& operand) {
+            using U = std::remove_cvref_t<T>;
+            if constexpr(array_expression<U>)
+                return U(FTL_FORWARD(operand));
+            else if constexpr(std::is_lvalue_reference_v<T>)
+                return array_ref_leaf<typename U::value_type, typename U::shape>{ operand.data() };
+            else
+                return array_value_leaf<U>{ FTL_MOVE(operand) };
+        }
+
+        // Scalars take the element type of floating point arrays, so that
+        // float arrays stay float when multiplied by a double literal.
+        // Otherwise they keep their own type, a * 0.5 of an integer array
+        // is computed in double as it would be for a single element.
+        template <typename Other, typename S>
+        constexpr auto as_operand_with(S&& operand) {
+            using element_type = typename std::remove_cvref_t<Other>::value_type;
+            using scalar_type = std::remove_cvref_t<S>;
+            if constexpr(std::is_arithmetic_v<scalar_type> && std::is_floating_point_v<element_type>)
+                return scalar_leaf<element_type>{ static_cast<element_type>(operand) };
+            else if constexpr(std::is_arithmetic_v<scalar_type>)
+                return scalar_leaf<scalar_type>{ operand };
+            else
+                return as_operand(FTL_FORWARD(operand));
+        }
+
+        struct no_operand {};
+
+        template <std::size_t N, typename First, typename... Rest>
+        struct nth_type_impl { using type = typename nth_type_impl<N - 1, Rest...>::type; };
+
+        template <typename First, typename... Rest>
+        struct nth_type_impl<0, First, Rest...> { using type = First; };
+
+        template <std::size_t N, typename... Types>
+        using nth_type = typename nth_type_impl<N, Types...>::type;
+
+        template <typename... Shapes>
+        struct common_shape { using type = void; };
+
+        template <typename First, typename... Rest>
+        struct common_shape<First, Rest...>
+        {
+            using rest = typename common_shape<Rest...>::type;
+            static_assert(std::is_void_v<First> || std::is_void_v<rest> || std::is_same_v<First, rest>,
+                          "element-wise operands have different shapes");
+            using type = std::conditional_t<std::is_void_v<First>, rest, First>;
+        };
+
+        struct op_add           { template <typename A, typename B> constexpr auto operator()(const A& a, const B& b) const { return a + b; } };
+        struct op_subtract      { template <typename A, typename B> constexpr auto operator()(const A& a, const B& b) const { return a - b; } };
+        struct op_multiply      { template <typename A, typename B> constexpr auto operator()(const A& a, const B& b) const { return a * b; } };
+        struct op_divide        { template <typename A, typename B> constexpr auto operator()(const A& a, const B& b) const { return a / b; } };
+        struct op_negate        { template <typename A> constexpr auto operator()(const A& a) const { return -a; } };
+
+        struct op_less          { template <typename A, typename B> constexpr bool operator()(const A& a, const B& b) const { return a < b; } };
+        struct op_less_equal    { template <typename A, typename B> constexpr bool operator()(const A& a, const B& b) const { return a <= b; } };
+        struct op_greater       { template <typename A, typename B> constexpr bool operator()(const A& a, const B& b) const { return a > b; } };
+        struct op_greater_equal { template <typename A, typename B> constexpr bool operator()(const A& a, const B& b) const { return a >= b; } };
+        struct op_equal         { template <typename A, typename B> constexpr bool operator()(const A& a, const B& b) const { return a == b; } };
+        struct op_not_equal     { template <typename A, typename B> constexpr bool operator()(const A& a, const B& b) const { return a != b; } };
+
+        struct op_select
+        {
+            template <typename M, typename A, typename B>
+            constexpr auto operator()(const M& mask, const A& a, const B& b) const { return mask ? a : b; }
+        };
+
+        // Fused only where the target has FMA instructions, a call to the
+        // library fma would stop the loop from being vectorised
+        struct op_fma
+        {
+            template <typename A, typename B, typename C>
+            constexpr auto operator()(const A& a, const B& b, const C& c) const {
+                #ifdef __FP_FAST_FMAF
+                if constexpr(std::is_same_v<A, float> && std::is_same_v<B, float> && std::is_same_v<C, float>) {
+                    if (not std::is_constant_evaluated())
+                        return __builtin_fmaf(a, b, c);
+                }
+                #endif
+                #ifdef __FP_FAST_FMA
+                if constexpr(std::is_same_v<A, double> && std::is_same_v<B, double> && std::is_same_v<C, double>) {
+                    if (not std::is_constant_evaluated())
+                        return __builtin_fma(a, b, c);
+                }
+                #endif
+                return a * b + c;
+            }
+        };
+    }
+
+    namespace detail {
+        // Operations that give zero for zero operands without raising
+        // floating point exceptions, so they can run over the padding
+        template <typename Op> constexpr bool keeps_zero_padding = false;
+        template <> constexpr bool keeps_zero_padding<op_add> = true;
+        template <> constexpr bool keeps_zero_padding<op_subtract> = true;
+        template <> constexpr bool keeps_zero_padding<op_multiply> = true;
+        template <> constexpr bool keeps_zero_padding<op_negate> = true;
+        template <> constexpr bool keeps_zero_padding<op_fma> = true;
+        template <> constexpr bool keeps_zero_padding<op_select> = true;
+        template <> constexpr bool keeps_zero_padding<op_less> = true;
+        template <> constexpr bool keeps_zero_padding<op_less_equal> = true;
+        template <> constexpr bool keeps_zero_padding<op_greater> = true;
+        template <> constexpr bool keeps_zero_padding<op_greater_equal> = true;
+        template <> constexpr bool keeps_zero_padding<op_equal> = true;
+        template <> constexpr bool keeps_zero_padding<op_not_equal> = true;
+    }
+
+    // Lazy element-wise expression, evaluated when assigned to an ftl::array
+    // or with ftl::eval().  Element i depends only on element i of each operand.
+    template <typename Op, typename... Operands>
+    struct array_expr : detail::array_expression_base
+    {
+        static_assert(sizeof...(Operands) >= 1 && sizeof...(Operands) <= 3);
+
+        using value_type    = std::remove_cvref_t<decltype(Op{}(std::declval<const Operands&>()[0]...))>;
+        using shape         = typename detail::common_shape<typename Operands::shape...>::type;
+
+        static_assert(not std::is_void_v<shape>, "element-wise expression needs at least one array operand");
+
+        constexpr static std::size_t padded_size = [] {
+            if (not detail::keeps_zero_padding<Op>)
+                return std::size_t(0);
+
+            std::size_t result = static_cast<std::size_t>(-1);
+            ((result = Operands::padded_size < result ? Operands::padded_size : result), ...);
+            return result;
+        }();
+
+        [[nodiscard]] constexpr static std::size_t size() noexcept { return shape::size; }
+
+        constexpr value_type operator[](std::size_t index) const {
+            return element(index, std::index_sequence_for<Operands...>{});
+        }
+
+        template <std::size_t... I>
+        constexpr value_type element(std::size_t index, std::index_sequence<I...>) const {
+            return Op{}(operand<I>()[index]...);
+        }
+
+        template <std::size_t I>
+        constexpr const auto& operand() const noexcept {
+            if constexpr(I == 0) return first;
+            else if constexpr(I == 1) return second;
+            else return third;
+        }
+
+        detail::nth_type<0, Operands...> first;
+        [[no_unique_address]] detail::nth_type<1, Operands..., detail::no_operand, detail::no_operand> second = {};
+        [[no_unique_address]] detail::nth_type<2, Operands..., detail::no_operand, detail::no_operand> third = {};
+    };
+
+    template <typename T>
+    concept array_operand = array_expression<std::remove_cvref_t<T>> || detail::is_ftl_array<std::remove_cvref_t<T>>::value;
+
+    template <typename T>
+    concept array_scalar = std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+    template <typename T>
+    concept array_operand_or_scalar = array_operand<T> || array_scalar<T>;
+
+    namespace detail {
+        // The first array operand gives the element type of the scalars
+        template <typename A, typename... Rest>
+        struct first_array_operand
+        {
+            using type = typename first_array_operand<Rest...>::type;
+        };
+
+        template <typename A, typename... Rest> requires array_operand<A>
+        struct first_array_operand<A, Rest...>
+        {
+            using type = std::remove_cvref_t<A>;
+        };
+
+        template <typename Op, typename... Args>
+        constexpr auto make_expr(Args&&... args) {
+            using reference_operand = typename first_array_operand<Args...>::type;
+            return array_expr<Op, decltype(as_operand_with<reference_operand>(FTL_FORWARD(args)))...> {
+                {}, as_operand_with<reference_operand>(FTL_FORWARD(args))...
+            };
+        }
+
+        template <typename L, typename R>
+        concept elementwise_operands = (array_operand<L> && array_operand_or_scalar<R>)
+                                    || (array_scalar<L> && array_operand<R>);
+    }
+
+    // arithmetic
+    template <typename L, typename R> requires detail::elementwise_operands<L, R>
+    [[nodiscard]] constexpr auto operator+(L&& lhs, R&& rhs) { return detail::make_expr<detail::op_add>(FTL_FORWARD(lhs), FTL_FORWARD(rhs)); }
+
+    template <typename L, typename R> requires detail::elementwise_operands<L, R>
+    [[nodiscard]] constexpr auto operator-(L&& lhs, R&& rhs) { return detail::make_expr<detail::op_subtract>(FTL_FORWARD(lhs), FTL_FORWARD(rhs)); }
+
+    template <typename L, typename R> requires detail::elementwise_operands<L, R>
+    [[nodiscard]] constexpr auto operator*(L&& lhs, R&& rhs) { return detail::make_expr<detail::op_multiply>(FTL_FORWARD(lhs), FTL_FORWARD(rhs)); }
+
+    template <typename L, typename R> requires detail::elementwise_operands<L, R>
+    [[nodiscard]] constexpr auto operator/(L&& lhs, R&& rhs) { return detail::make_expr<detail::op_divide>(FTL_FORWARD(lhs), FTL_FORWARD(rhs)); }
+
+    template <array_operand A>
+    [[nodiscard]] constexpr auto operator-(A&& operand) { return detail::make_expr<detail::op_negate>(FTL_FORWARD(operand)); }
+
+    // a * b + c in one rounding where the target supports it
+    template <typename A, typename B, typename C>
+        requires array_operand_or_scalar<A> && array_operand_or_scalar<B> && array_operand_or_scalar<C>
+              && (array_operand<A> || array_operand<B> || array_operand<C>)
+    [[nodiscard]] constexpr auto fma(A&& a, B&& b, C&& c) {
+        return detail::make_expr<detail::op_fma>(FTL_FORWARD(a), FTL_FORWARD(b), FTL_FORWARD(c));
+    }
+
+    // comparisons, == and != compare whole arrays so equal() and not_equal()
+    // are the element-wise versions
+    template <typename L, typename R> requires detail::elementwise_operands<L, R>
+    [[nodiscard]] constexpr auto operator<(L&& lhs, R&& rhs) { return detail::make_expr<detail::op_less>(FTL_FORWARD(lhs), FTL_FORWARD(rhs)); }
+
+    template <typename L, typename R> requires detail::elementwise_operands<L, R>
+    [[nodiscard]] constexpr auto operator<=(L&& lhs, R&& rhs) { return detail::make_expr<detail::op_less_equal>(FTL_FORWARD(lhs), FTL_FORWARD(rhs)); }
+
+    template <typename L, typename R> requires detail::elementwise_operands<L, R>
+    [[nodiscard]] constexpr auto operator>(L&& lhs, R&& rhs) { return detail::make_expr<detail::op_greater>(FTL_FORWARD(lhs), FTL_FORWARD(rhs)); }
+
+    template <typename L, typename R> requires detail::elementwise_operands<L, R>
+    [[nodiscard]] constexpr auto operator>=(L&& lhs, R&& rhs) { return detail::make_expr<detail::op_greater_equal>(FTL_FORWARD(lhs), FTL_FORWARD(rhs)); }
+
+    template <typename L, typename R> requires detail::elementwise_operands<L, R>
+    [[nodiscard]] constexpr auto equal(L&& lhs, R&& rhs) { return detail::make_expr<detail::op_equal>(FTL_FORWARD(lhs), FTL_FORWARD(rhs)); }
+
+    template <typename L, typename R> requires detail::elementwise_operands<L, R>
+    [[nodiscard]] constexpr auto not_equal(L&& lhs, R&& rhs) { return detail::make_expr<detail::op_not_equal>(FTL_FORWARD(lhs), FTL_FORWARD(rhs)); }
+
+    // Element-wise mask ? a : b
+    template <array_operand M, typename A, typename B>
+        requires array_operand_or_scalar<A> && array_operand_or_scalar<B> && (array_operand<A> || array_operand<B>)
+    [[nodiscard]] constexpr auto select(M&& mask, A&& a, B&& b) {
+        if constexpr(array_operand<A>) {
+            using reference_operand = std::remove_cvref_t<A>;
+            return array_expr<detail::op_select,
+                              decltype(detail::as_operand(FTL_FORWARD(mask))),
+                              decltype(detail::as_operand_with<reference_operand>(FTL_FORWARD(a))),
+                              decltype(detail::as_operand_with<reference_operand>(FTL_FORWARD(b)))> {
+                {}, detail::as_operand(FTL_FORWARD(mask)),
+                    detail::as_operand_with<reference_operand>(FTL_FORWARD(a)),
+                    detail::as_operand_with<reference_operand>(FTL_FORWARD(b))
+            };
+        } else {
+            using reference_operand = std::remove_cvref_t<B>;
+            return array_expr<detail::op_select,
+                              decltype(detail::as_operand(FTL_FORWARD(mask))),
+                              decltype(detail::as_operand_with<reference_operand>(FTL_FORWARD(a))),
+                              decltype(detail::as_operand_with<reference_operand>(FTL_FORWARD(b)))> {
+                {}, detail::as_operand(FTL_FORWARD(mask)),
+                    detail::as_operand_with<reference_operand>(FTL_FORWARD(a)),
+                    detail::as_operand_with<reference_operand>(FTL_FORWARD(b))
+            };
+        }
+    }
+
+    // Evaluates an expression to an array of its element type
+    template <array_expression E>
+    [[nodiscard]] constexpr auto eval(const E& expr) {
+        return typename E::shape::template array_type<typename E::value_type>(expr);
+    }
+
+    // compound assignment, evaluated in one pass
+    template <typename T, typename Layout, std::size_t... Dimensions, array_operand_or_scalar R>
+    constexpr basic_array<T, Layout, Dimensions...>& operator+=(basic_array<T, Layout, Dimensions...>& lhs, R&& rhs) { return lhs = lhs + FTL_FORWARD(rhs); }
+
+    template <typename T, typename Layout, std::size_t... Dimensions, array_operand_or_scalar R>
+    constexpr basic_array<T, Layout, Dimensions...>& operator-=(basic_array<T, Layout, Dimensions...>& lhs, R&& rhs) { return lhs = lhs - FTL_FORWARD(rhs); }
+
+    template <typename T, typename Layout, std::size_t... Dimensions, array_operand_or_scalar R>
+    constexpr basic_array<T, Layout, Dimensions...>& operator*=(basic_array<T, Layout, Dimensions...>& lhs, R&& rhs) { return lhs = lhs * FTL_FORWARD(rhs); }
+
+    template <typename T, typename Layout, std::size_t... Dimensions, array_operand_or_scalar R>
+    constexpr basic_array<T, Layout, Dimensions...>& operator/=(basic_array<T, Layout, Dimensions...>& lhs, R&& rhs) { return lhs = lhs / FTL_FORWARD(rhs); }
+
+    // Summation policies for sum(), dot() and the norms.
+    //
+    // multi_accumulator keeps Lanes independent partial sums, which lets the
+    // compiler keep them in vector registers without reordering additions
+    // itself.  kahan_summation carries the rounding error of every addition
+    // and pairwise_summation adds halves recursively, both lose less precision
+    // on long floating-point arrays.  Neither survives -ffast-math.
+    template <std::size_t Lanes = 16>
+    struct multi_accumulator
+    {
+        static_assert(Lanes > 0);
+        constexpr static std::size_t lanes = Lanes;
+    };
+
+    struct kahan_summation {};
+
+    template <std::size_t BlockSize = 32>
+    struct pairwise_summation
+    {
+        static_assert(BlockSize > 0);
+        constexpr static std::size_t block_size = BlockSize;
+    };
+
+    using default_summation = multi_accumulator<>;
+
+    namespace detail {
+        template <typename X>
+        constexpr decltype(auto) element_at(const X& x, std::size_t index) {
+            if constexpr(array_expression<X>)
+                return x[index];
+            else
+                return x.data()[index];
+        }
+
+        template <typename X>
+        using element_type = std::remove_cvref_t<decltype(element_at(std::declval<const X&>(), 0))>;
+
+        // Reduces x[first, last) with Lanes accumulators, Combine must be
+        // associative and commutative
+        template <std::size_t Lanes, typename Acc, typename Get, typename Combine>
+        constexpr Acc reduce_lanes(std::size_t first, std::size_t last, Acc init, const Get& get, const Combine& combine) {
+            Acc acc[Lanes];
+            for (std::size_t lane = 0; lane < Lanes; ++lane)
+                acc[lane] = init;
+
+            std::size_t i = first;
+            for (; i + Lanes <= last; i += Lanes) {
+                for (std::size_t lane = 0; lane < Lanes; ++lane)
+                    acc[lane] = combine(acc[lane], get(i + lane));
+            }
+            for (std::size_t lane = 0; lane < Lanes && i + lane < last; ++lane)
+                acc[lane] = combine(acc[lane], get(i + lane));
+
+            Acc result = acc[0];
+            for (std::size_t lane = 1; lane < Lanes; ++lane)
+                result = combine(result, acc[lane]);
+            return result;
+        }
+
+        template <typename Acc, typename Get>
+        constexpr Acc pairwise_sum(std::size_t first, std::size_t last, std::size_t block_size, const Get& get) {
+            if (last - first <= block_size) {
+                Acc acc = Acc();
+                for (std::size_t i = first; i < last; ++i)
+                    acc += get(i);
+                return acc;
+            }
+            const std::size_t middle = first + (last - first) / 2;
+            return pairwise_sum<Acc>(first, middle, block_size, get) + pairwise_sum<Acc>(middle, last, block_size, get);
+        }
+
+        template <typename Acc, typename Summation, typename Get>
+        constexpr Acc summation(std::size_t size, const Get& get) {
+            if constexpr(std::is_same_v<Summation, kahan_summation>) {
+                Acc sum = Acc();
+                Acc compensation = Acc();
+                for (std::size_t i = 0; i < size; ++i) {
+                    const Acc y = static_cast<Acc>(get(i)) - compensation;
+                    const Acc t = sum + y;
+                    compensation = (t - sum) - y;
+                    sum = t;
+                }
+                return sum;
+            } else if constexpr(requires { Summation::block_size; }) {
+                return pairwise_sum<Acc>(0, size, Summation::block_size, get);
+            } else {
+                return reduce_lanes<Summation::lanes, Acc>(0, size, Acc(), get,
+                    [](const Acc& a, const Acc& b) { return a + b; });
+            }
+        }
+
+        constexpr float sqrt(float x) noexcept { return __builtin_sqrtf(x); }
+        constexpr double sqrt(double x) noexcept { return __builtin_sqrt(x); }
+        constexpr long double sqrt(long double x) noexcept { return __builtin_sqrtl(x); }
+    }
+
+    // Reductions over arrays and element-wise expressions.  The size is known
+    // at compile time, so small arrays are unrolled completely.
+
+    template <typename Summation = default_summation, array_operand X>
+    [[nodiscard]] constexpr auto sum(const X& x) {
+        // promoted like dot, so small integer and bool elements do not wrap
+        using acc_type = decltype(detail::element_at(x, 0) + detail::element_at(x, 0));
+        return detail::summation<acc_type, Summation>(X::shape::size,
+            [&x](std::size_t i) { return detail::element_at(x, i); });
+    }
+
+    template <typename Summation = default_summation, array_operand A, array_operand B>
+        requires std::is_same_v<typename A::shape, typename B::shape>
+    [[nodiscard]] constexpr auto dot(const A& a, const B& b) {
+        using acc_type = decltype(detail::element_at(a, 0) * detail::element_at(b, 0));
+        return detail::summation<acc_type, Summation>(A::shape::size,
+            [&a, &b](std::size_t i) { return detail::element_at(a, i) * detail::element_at(b, i); });
+    }
+
+    // Sum of squares
+    template <typename Summation = default_summation, array_operand X>
+    [[nodiscard]] constexpr auto squared_norm(const X& x) { return dot<Summation>(x, x); }
+
+    // Euclidean length, in double for integer elements
+    template <typename Summation = default_summation, array_operand X>
+    [[nodiscard]] constexpr auto norm2(const X& x) {
+        const auto squares = squared_norm<Summation>(x);
+        if constexpr(std::is_floating_point_v<decltype(squares)>)
+            return detail::sqrt(squares);
+        else
+            return detail::sqrt(static_cast<double>(squares));
+    }
+
+    template <array_operand X>
+    [[nodiscard]] constexpr auto min_value(const X& x) {
+        using value_type = detail::element_type<X>;
+        return detail::reduce_lanes<default_summation::lanes, value_type>(1, X::shape::size, detail::element_at(x, 0),
+            [&x](std::size_t i) { return detail::element_at(x, i); },
+            [](const value_type& a, const value_type& b) { return b < a ? b : a; });
+    }
+
+    template <array_operand X>
+    [[nodiscard]] constexpr auto max_value(const X& x) {
+        using value_type = detail::element_type<X>;
+        return detail::reduce_lanes<default_summation::lanes, value_type>(1, X::shape::size, detail::element_at(x, 0),
+            [&x](std::size_t i) { return detail::element_at(x, i); },
+            [](const value_type& a, const value_type& b) { return a < b ? b : a; });
+    }
+
+    // Index of the first smallest / largest element in storage order
+    template <array_operand X>
+    [[nodiscard]] constexpr std::size_t min_element(const X& x) {
+        std::size_t found = 0;
+        for (std::size_t i = 1; i < X::shape::size; ++i) {
+            if (detail::element_at(x, i) < detail::element_at(x, found))
+                found = i;
+        }
+        return found;
+    }
+
+    template <array_operand X>
+    [[nodiscard]] constexpr std::size_t max_element(const X& x) {
+        std::size_t found = 0;
+        for (std::size_t i = 1; i < X::shape::size; ++i) {
+            if (detail::element_at(x, found) < detail::element_at(x, i))
+                found = i;
+        }
+        return found;
+    }
+
+    // Whether any / all elements convert to true, every element is looked at
+    // so that the loop stays branch-free
+    template <array_operand X>
+    [[nodiscard]] constexpr bool any(const X& x) {
+        return detail::reduce_lanes<default_summation::lanes, bool>(0, X::shape::size, false,
+            [&x](std::size_t i) { return static_cast<bool>(detail::element_at(x, i)); },
+            [](bool a, bool b) { return a || b; });
+    }
+
+    template <array_operand X>
+    [[nodiscard]] constexpr bool all(const X& x) {
+        return detail::reduce_lanes<default_summation::lanes, bool>(0, X::shape::size, true,
+            [&x](std::size_t i) { return static_cast<bool>(detail::element_at(x, i)); },
+            [](bool a, bool b) { return a && b; });
+    }
+
+}
+
+#endif
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
@@ -0,0 +1,180 @@
+#ifndef FTL_ARRAY_PARALLEL_HPP
+#define FTL_ARRAY_PARALLEL_HPP
+
+// Needs ftl::thread_pool, so this header is empty in freestanding
+// environments.
+#if __STDC_HOSTED__ == 1
+
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "utility.hpp"
+#include "array.hpp"
+#include "thread_pool.hpp"
+
+namespace ftl::parallel
+{
+    // How the partial results of reduce are combined.  deterministic splits
+    // the array the same way whatever the number of threads and combines the
+    // chunks in storage order, so floating point results are repeatable;
+    // unordered gives each thread one chunk and combines them as they finish.
+    enum class reduction_order
+    {
+        deterministic,
+        unordered,
+    };
+
+    namespace detail {
+        // Elements given to one task, small enough that a chunk of both input
+        // and output stays in L1, and a whole number of cache lines so that
+        // tasks on aligned arrays never write to the same line
+        constexpr std::size_t chunk_bytes = 16 * 1024;
+
+        template <typename T>
+        constexpr std::size_t chunk_size = chunk_bytes / sizeof(T) > 0 ? chunk_bytes / sizeof(T) : 1;
+
+        constexpr std::size_t chunk_count(std::size_t size, std::size_t chunk) noexcept {
+            return (size + chunk - 1) / chunk;
+        }
+
+        // Row-major indices of flat position, then one step at a time
+        template <typename Array>
+        constexpr void unflatten(std::size_t position, std::size_t* indices) noexcept {
+            for (std::size_t d = Array::dimension; d-- > 0;) {
+                indices[d] = position % Array::extent(d);
+                position /= Array::extent(d);
+            }
+        }
+
+        template <typename Array>
+        constexpr void next_index(std::size_t* indices) noexcept {
+            for (std::size_t d = Array::dimension; d-- > 0;) {
+                if (++indices[d] < Array::extent(d))
+                    return;
+                indices[d] = 0;
+            }
+        }
+
+        template <typename Array, typename F, std::size_t... I>
+        void call_with_index(Array& arr, F& fn, const std::size_t* indices, std::index_sequence<I...>) {
+            fn(arr.at(indices[I]...), indices[I]...);
+        }
+
+        template <typename Array, typename F>
+        void for_each_index(thread_pool& pool, Array& arr, F& fn) {
+            constexpr std::size_t size = Array::size();
+            constexpr std::size_t chunk = chunk_size<typename Array::value_type>;
+
+            ftl::parallel_for(pool, std::size_t(0), chunk_count(size, chunk), [&](std::size_t c) {
+                const std::size_t last = (c + 1) * chunk < size ? (c + 1) * chunk : size;
+
+                std::size_t indices[Array::dimension];
+                unflatten<Array>(c * chunk, indices);
+                for (std::size_t i = c * chunk; i < last; ++i) {
+                    call_with_index(arr, fn, indices, std::make_index_sequence<Array::dimension>{});
+                    next_index<Array>(indices);
+                }
+            });
+        }
+    }
+
+    // output[i] = fn(input[i]) for every element, in chunks on the pool
+    template <typename T, typename U, typename Layout, std::size_t... Dimensions, typename F>
+    void transform(thread_pool& pool, const basic_array<T, Layout, Dimensions...>& input,
+                   basic_array<U, Layout, Dimensions...>& output, F&& fn)
+    {
+        constexpr std::size_t size = basic_array<T, Layout, Dimensions...>::size();
+        constexpr std::size_t chunk = detail::chunk_size<U>;
+
+        const T* source = input.data();
+        U* target = output.data();
+        ftl::parallel_for(pool, std::size_t(0), detail::chunk_count(size, chunk), [&](std::size_t c) {
+            const std::size_t last = (c + 1) * chunk < size ? (c + 1) * chunk : size;
+            for (std::size_t i = c * chunk; i < last; ++i)
+                target[i] = fn(source[i]);
+        });
+    }
+
+    // Calls fn(element, i, j, ...) for every element of the array on the
+    // pool, each task going through a run of row-major indices
+    template <typename T, typename Layout, std::size_t... Dimensions, typename F>
+    void for_each_index(thread_pool& pool, basic_array<T, Layout, Dimensions...>& arr, F&& fn)
+    {
+        detail::for_each_index(pool, arr, fn);
+    }
+
+    template <typename T, typename Layout, std::size_t... Dimensions, typename F>
+    void for_each_index(thread_pool& pool, const basic_array<T, Layout, Dimensions...>& arr, F&& fn)
+    {
+        detail::for_each_index(pool, arr, fn);
+    }
+
+    // op(op(init, a), b)... over the elements in storage order within each
+    // chunk, and the chunk results combined with op the same way.  op has
+    // to be associative, init is used once per chunk so it should be the
+    // identity of op.
+    template <typename T, typename Layout, std::size_t... Dimensions, typename R, typename Op>
+    [[nodiscard]] R reduce(thread_pool& pool, const basic_array<T, Layout, Dimensions...>& arr, R init, Op op,
+                           reduction_order order = reduction_order::deterministic)
+    {
+        constexpr std::size_t size = basic_array<T, Layout, Dimensions...>::size();
+        const T* source = arr.data();
+
+        std::size_t chunk = detail::chunk_size<T>;
+        if (order == reduction_order::unordered)
+            chunk = size / pool.size() + 1;
+
+        const std::size_t count = detail::chunk_count(size, chunk);
+        auto reduce_chunk = [&](std::size_t c) {
+            const std::size_t last = (c + 1) * chunk < size ? (c + 1) * chunk : size;
+            R result = init;
+            for (std::size_t i = c * chunk; i < last; ++i)
+                result = op(result, source[i]);
+            return result;
+        };
+
+        if (order == reduction_order::deterministic) {
+            std::vector<R> partial(count, init);
+            ftl::parallel_for(pool, std::size_t(0), count, [&](std::size_t c) { partial[c] = reduce_chunk(c); }, std::size_t(1));
+
+            R result = init;
+            for (const R& value : partial)
+                result = op(result, value);
+            return result;
+        }
+
+        std::mutex result_mutex;
+        R result = init;
+        ftl::parallel_for(pool, std::size_t(0), count, [&](std::size_t c) {
+            R value = reduce_chunk(c);
+            std::lock_guard<std::mutex> lock(result_mutex);
+            result = op(result, value);
+        }, std::size_t(1));
+        return result;
+    }
+}
+
+#endif
+#endif
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
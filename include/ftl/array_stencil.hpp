@@ -0,0 +1,227 @@
+#ifndef FTL_ARRAY_STENCIL_HPP
+#define FTL_ARRAY_STENCIL_HPP
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "utility.hpp"
+#include "array.hpp"
+
+namespace ftl
+{
+    // Boundary policies, what a neighbourhood reads past the edges of the
+    // array
+
+    // The nearest element on the edge
+    struct clamp_boundary {};
+
+    // The array repeats, reading past one edge continues from the other
+    struct wrap_boundary {};
+
+    // A fixed value
+    template <typename T>
+    struct constant_boundary
+    {
+        T value;
+    };
+
+    // Nothing, elements whose neighbourhood crosses an edge are not visited
+    struct skip_boundary {};
+
+    namespace detail {
+        template <typename Policy>
+        constexpr bool is_constant_boundary = false;
+
+        template <typename T>
+        constexpr bool is_constant_boundary<constant_boundary<T>> = true;
+
+        // Index of position along an extent under the policy, false if the
+        // policy has no element there
+        template <typename Policy>
+        constexpr bool boundary_index(std::ptrdiff_t position, std::size_t extent, std::size_t& result) noexcept {
+            const std::ptrdiff_t last = static_cast<std::ptrdiff_t>(extent) - 1;
+            if constexpr(std::is_same_v<Policy, clamp_boundary>) {
+                result = static_cast<std::size_t>(position < 0 ? 0 : position > last ? last : position);
+                return true;
+            } else if constexpr(std::is_same_v<Policy, wrap_boundary>) {
+                const std::ptrdiff_t size = static_cast<std::ptrdiff_t>(extent);
+                result = static_cast<std::size_t>(((position % size) + size) % size);
+                return true;
+            } else {
+                result = static_cast<std::size_t>(position);
+                return position >= 0 && position <= last;
+            }
+        }
+
+        // Neighbourhood of an element at least Radius from every edge,
+        // read without any checks
+        template <typename Array>
+        struct interior_neighbourhood
+        {
+            using value_type = typename Array::value_type;
+
+            const Array&    arr;
+            std::size_t     position[Array::dimension];
+
+            template <typename... Offset>
+                requires (sizeof...(Offset) == Array::dimension)
+            [[nodiscard]] constexpr const value_type& at(Offset... offset) const noexcept {
+                return element(std::make_index_sequence<Array::dimension>{}, offset...);
+            }
+
+            [[nodiscard]] constexpr const value_type& centre() const noexcept {
+                return element_at(std::make_index_sequence<Array::dimension>{}, position);
+            }
+
+            [[nodiscard]] constexpr std::size_t index(std::size_t d) const noexcept { return position[d]; }
+
+            private:
+                template <std::size_t... I, typename... Offset>
+                constexpr const value_type& element(std::index_sequence<I...>, Offset... offset) const noexcept {
+                    return arr.at((position[I] + static_cast<std::size_t>(static_cast<std::ptrdiff_t>(offset)))...);
+                }
+
+                template <std::size_t... I>
+                constexpr const value_type& element_at(std::index_sequence<I...>, const std::size_t* indices) const noexcept {
+                    return arr.at(indices[I]...);
+                }
+        };
+
+        // Neighbourhood of an element near an edge, every read goes through
+        // the boundary policy
+        template <typename Array, typename Policy>
+        struct edge_neighbourhood
+        {
+            using value_type = typename Array::value_type;
+
+            const Array&    arr;
+            const Policy&   policy;
+            std::size_t     position[Array::dimension];
+
+            template <typename... Offset>
+                requires (sizeof...(Offset) == Array::dimension)
+            [[nodiscard]] constexpr value_type at(Offset... offset) const noexcept {
+                const std::ptrdiff_t offsets[] = { static_cast<std::ptrdiff_t>(offset)... };
+
+                std::size_t indices[Array::dimension];
+                for (std::size_t d = 0; d < Array::dimension; ++d) {
+                    if (not boundary_index<Policy>(static_cast<std::ptrdiff_t>(position[d]) + offsets[d], Array::extent(d), indices[d])) {
+                        if constexpr(is_constant_boundary<Policy>)
+                            return static_cast<value_type>(policy.value);
+                    }
+                }
+                return element_at(std::make_index_sequence<Array::dimension>{}, indices);
+            }
+
+            [[nodiscard]] constexpr value_type centre() const noexcept {
+                return element_at(std::make_index_sequence<Array::dimension>{}, position);
+            }
+
+            [[nodiscard]] constexpr std::size_t index(std::size_t d) const noexcept { return position[d]; }
+
+            private:
+                template <std::size_t... I>
+                constexpr const value_type& element_at(std::index_sequence<I...>, const std::size_t* indices) const noexcept {
+                    return arr.at(indices[I]...);
+                }
+        };
+
+        template <typename F, typename Neighbourhood, std::size_t... I>
+        constexpr void call_stencil(F& f, const Neighbourhood& neighbourhood, std::index_sequence<I...>) {
+            f(neighbourhood, neighbourhood.position[I]...);
+        }
+
+        template <typename Array, typename Policy, typename F>
+        constexpr void visit_edge(const Array& arr, const Policy& policy, F& f, const std::size_t* position) {
+            if constexpr(not std::is_same_v<Policy, skip_boundary>) {
+                edge_neighbourhood<Array, Policy> neighbourhood{ arr, policy, {} };
+                for (std::size_t d = 0; d < Array::dimension; ++d)
+                    neighbourhood.position[d] = position[d];
+                call_stencil(f, neighbourhood, std::make_index_sequence<Array::dimension>{});
+            }
+        }
+
+        // One dimension of the loop.  Only once every outer index is in the
+        // interior does the innermost dimension get a loop without checks,
+        // the rows near an edge go through the policy
+        template <std::size_t Radius, std::size_t Dim, typename Array, typename Policy, typename F>
+        constexpr void stencil_loop(const Array& arr, const Policy& policy, F& f, std::size_t* position, bool interior) {
+            constexpr std::size_t extent = Array::extent(Dim);
+            constexpr std::size_t low = Radius < extent ? Radius : extent;
+            constexpr std::size_t high = extent > 2 * Radius ? extent - Radius : low;
+
+            if constexpr(Dim + 1 < Array::dimension) {
+                for (std::size_t i = 0; i < extent; ++i) {
+                    const bool inside = interior && i >= low && i < high;
+                    if constexpr(std::is_same_v<Policy, skip_boundary>) {
+                        if (not inside)
+                            continue;
+                    }
+                    position[Dim] = i;
+                    stencil_loop<Radius, Dim + 1>(arr, policy, f, position, inside);
+                }
+            } else if (interior) {
+                for (std::size_t i = 0; i < low; ++i) {
+                    position[Dim] = i;
+                    visit_edge(arr, policy, f, position);
+                }
+
+                interior_neighbourhood<Array> neighbourhood{ arr, {} };
+                for (std::size_t d = 0; d < Dim; ++d)
+                    neighbourhood.position[d] = position[d];
+                for (std::size_t i = low; i < high; ++i) {
+                    neighbourhood.position[Dim] = i;
+                    call_stencil(f, neighbourhood, std::make_index_sequence<Array::dimension>{});
+                }
+
+                for (std::size_t i = high; i < extent; ++i) {
+                    position[Dim] = i;
+                    visit_edge(arr, policy, f, position);
+                }
+            } else {
+                for (std::size_t i = 0; i < extent; ++i) {
+                    position[Dim] = i;
+                    visit_edge(arr, policy, f, position);
+                }
+            }
+        }
+    }
+
+    // Calls f(neighbourhood, i, j, ...) for every element of the array, where
+    // neighbourhood.at(di, dj, ...) reads the element at an offset of at most
+    // Radius in each dimension and centre() the element itself.  Elements at
+    // least Radius from every edge are visited in a loop that reads the array
+    // directly and can be vectorised, the rest through the boundary policy:
+    // clamp_boundary, wrap_boundary, constant_boundary<T> or skip_boundary.
+    template <std::size_t Radius, typename T, typename Layout, std::size_t... Dimensions, typename Policy, typename F>
+    constexpr void for_each_stencil(const basic_array<T, Layout, Dimensions...>& arr, const Policy& policy, F&& f) {
+        static_assert(std::is_same_v<Policy, clamp_boundary> || std::is_same_v<Policy, wrap_boundary>
+                      || std::is_same_v<Policy, skip_boundary> || detail::is_constant_boundary<Policy>,
+                      "unknown boundary policy");
+
+        std::size_t position[sizeof...(Dimensions)] = {};
+        detail::stencil_loop<Radius, 0>(arr, policy, f, position, true);
+    }
+}
+
+#endif
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
@@ -0,0 +1,232 @@
+#ifndef FTL_BIT_ARRAY_HPP
+#define FTL_BIT_ARRAY_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+#include "utility.hpp"
+
+namespace ftl
+{
+    // Fixed-size multi-dimensional array of bits, packed row-major into 64-bit
+    // words.  Bits past size() in the last word are kept zero, so whole-array
+    // operations work a word at a time.  Positions given to and returned from
+    // find_first and find_next are row-major flat indices.
+    template <std::size_t... Dimensions>
+    class bit_array
+    {
+        public:
+            using word_type         = uint64_t;
+            using size_type         = std::size_t;
+
+            constexpr static size_type dimension = sizeof...(Dimensions);
+            constexpr static size_type word_bits = 64;
+            constexpr static size_type word_count = ((Dimensions * ...) + word_bits - 1) / word_bits;
+
+            // Returned by find_first and find_next when no bit is set
+            constexpr static size_type npos = (Dimensions * ...);
+
+            class reference
+            {
+                public:
+                    constexpr reference(word_type& word, word_type mask) noexcept : word(&word), mask(mask) {}
+                    constexpr reference(const reference&) noexcept = default;
+
+                    constexpr reference& operator=(bool value) noexcept {
+                        if (value)
+                            *word |= mask;
+                        else
+                            *word &= ~mask;
+                        return *this;
+                    }
+
+                    constexpr reference& operator=(const reference& other) noexcept { return *this = static_cast<bool>(other); }
+
+                    constexpr operator bool() const noexcept { return (*word & mask) != 0; }
+                    constexpr bool operator~() const noexcept { return (*word & mask) == 0; }
+
+                    constexpr reference& flip() noexcept {
+                        *word ^= mask;
+                        return *this;
+                    }
+
+                private:
+                    word_type*  word;
+                    word_type   mask;
+            };
+
+            constexpr bit_array() noexcept = default;
+
+            // element access
+            template <typename... Index>
+                requires (sizeof...(Index) == dimension && (std::is_convertible_v<Index, size_type> && ...))
+            [[nodiscard]] constexpr reference at(Index... index) noexcept {
+                const size_type position = offset_of(index...);
+                return reference(words[position / word_bits], bit_mask(position));
+            }
+
+            template <typename... Index>
+                requires (sizeof...(Index) == dimension && (std::is_convertible_v<Index, size_type> && ...))
+            [[nodiscard]] constexpr bool at(Index... index) const noexcept {
+                return test(offset_of(index...));
+            }
+
+            [[nodiscard]] constexpr reference operator[](size_type position) noexcept requires (dimension == 1) {
+                return reference(words[position / word_bits], bit_mask(position));
+            }
+
+            [[nodiscard]] constexpr bool operator[](size_type position) const noexcept requires (dimension == 1) {
+                return test(position);
+            }
+
+            [[nodiscard]] constexpr bool test(size_type position) const noexcept {
+                return (words[position / word_bits] & bit_mask(position)) != 0;
+            }
+
+            [[nodiscard]] constexpr word_type* data() noexcept { return words; }
+            [[nodiscard]] constexpr const word_type* data() const noexcept { return words; }
+
+            // capacity
+            [[nodiscard]] constexpr static size_type size() noexcept { return (Dimensions * ...); }
+            [[nodiscard]] constexpr static size_type extent(size_type d) noexcept { return dim_size[d]; }
+            [[nodiscard]] constexpr static size_type byte_size() noexcept { return word_count * sizeof(word_type); }
+
+            // operations
+            constexpr bit_array& set() noexcept {
+                for (word_type& w : words)
+                    w = ~word_type(0);
+                clear_tail();
+                return *this;
+            }
+
+            constexpr bit_array& reset() noexcept {
+                for (word_type& w : words)
+                    w = 0;
+                return *this;
+            }
+
+            constexpr bit_array& flip() noexcept {
+                for (word_type& w : words)
+                    w = ~w;
+                clear_tail();
+                return *this;
+            }
+
+            [[nodiscard]] constexpr size_type count() const noexcept {
+                size_type result = 0;
+                for (word_type w : words)
+                    result += static_cast<size_type>(__builtin_popcountll(w));
+                return result;
+            }
+
+            [[nodiscard]] constexpr bool any() const noexcept {
+                word_type combined = 0;
+                for (word_type w : words)
+                    combined |= w;
+                return combined != 0;
+            }
+
+            [[nodiscard]] constexpr bool none() const noexcept { return not any(); }
+            [[nodiscard]] constexpr bool all() const noexcept { return count() == size(); }
+
+            [[nodiscard]] constexpr size_type find_first() const noexcept { return find_from_word(0); }
+
+            // First set bit after position
+            [[nodiscard]] constexpr size_type find_next(size_type position) const noexcept {
+                ++position;
+                if (position >= size())
+                    return npos;
+
+                const size_type index = position / word_bits;
+                const word_type rest = words[index] & (~word_type(0) << (position % word_bits));
+                if (rest != 0)
+                    return index * word_bits + static_cast<size_type>(__builtin_ctzll(rest));
+                return find_from_word(index + 1);
+            }
+
+            constexpr bit_array& operator&=(const bit_array& other) noexcept {
+                for (size_type i = 0; i < word_count; ++i)
+                    words[i] &= other.words[i];
+                return *this;
+            }
+
+            constexpr bit_array& operator|=(const bit_array& other) noexcept {
+                for (size_type i = 0; i < word_count; ++i)
+                    words[i] |= other.words[i];
+                return *this;
+            }
+
+            constexpr bit_array& operator^=(const bit_array& other) noexcept {
+                for (size_type i = 0; i < word_count; ++i)
+                    words[i] ^= other.words[i];
+                return *this;
+            }
+
+            [[nodiscard]] constexpr bit_array operator~() const noexcept {
+                bit_array result = *this;
+                result.flip();
+                return result;
+            }
+
+            [[nodiscard]] friend constexpr bit_array operator&(bit_array lhs, const bit_array& rhs) noexcept { return lhs &= rhs; }
+            [[nodiscard]] friend constexpr bit_array operator|(bit_array lhs, const bit_array& rhs) noexcept { return lhs |= rhs; }
+            [[nodiscard]] friend constexpr bit_array operator^(bit_array lhs, const bit_array& rhs) noexcept { return lhs ^= rhs; }
+
+            [[nodiscard]] friend constexpr bool operator==(const bit_array& lhs, const bit_array& rhs) noexcept {
+                for (size_type i = 0; i < word_count; ++i)
+                    if (lhs.words[i] != rhs.words[i])
+                        return false;
+                return true;
+            }
+
+        private:
+            constexpr static word_type bit_mask(size_type position) noexcept {
+                return word_type(1) << (position % word_bits);
+            }
+
+            template <typename... Index>
+            constexpr static size_type offset_of(Index... index) noexcept {
+                const size_type indices[] = { static_cast<size_type>(index)... };
+                size_type offset = indices[0];
+                for (size_type d = 1; d < dimension; ++d)
+                    offset = offset * dim_size[d] + indices[d];
+                return offset;
+            }
+
+            constexpr size_type find_from_word(size_type index) const noexcept {
+                for (; index < word_count; ++index)
+                    if (words[index] != 0)
+                        return index * word_bits + static_cast<size_type>(__builtin_ctzll(words[index]));
+                return npos;
+            }
+
+            constexpr void clear_tail() noexcept {
+                if constexpr(size() % word_bits != 0)
+                    words[word_count - 1] &= ~word_type(0) >> (word_bits - size() % word_bits);
+            }
+
+            constexpr static size_type dim_size[] = { Dimensions... };
+            word_type words[word_count] = {};
+    };
+}
+
+#endif
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
@@ -0,0 +1,387 @@
+#ifndef FTL_DYN_ARRAY_HPP
+#define FTL_DYN_ARRAY_HPP
+
+#include <cstdint>
+#include <type_traits>
+#include <new>
+
+#include "memory.hpp"
+#include "utility.hpp"
+
+#if __STDC_HOSTED__ == 1
+# include <stdexcept>
+# include <memory>
+# include <cassert>
+# define FTL_EXCEPT_DYN_ARRAY_TOO_LARGE std::length_error("dyn_array does not fit its static storage")
+#else
+# define FTL_EXCEPT_DYN_ARRAY_TOO_LARGE
+# include <assert.h>
+#endif
+
+namespace ftl
+{
+    namespace detail {
+        template <typename T, typename Storage>
+        struct dyn_array_storage
+        {
+            static_assert(any_with_required_allocator_traits<Storage>, "Could not use provided storage type as allocator or static storage");
+        };
+
+        // Elements in one allocation of exactly the number needed
+        template <typename T, any_with_required_allocator_traits Allocator>
+        struct dyn_array_storage<T, Allocator>
+        {
+            using allocator_traits  = std::allocator_traits<Allocator>;
+            using allocator_type    = Allocator;
+            using size_type         = std::size_t;
+
+            static_assert(std::is_same_v<T, typename allocator_traits::value_type>);
+
+            constexpr static bool is_dynamic = true;
+
+            constexpr dyn_array_storage() noexcept = default;
+            constexpr explicit dyn_array_storage(const allocator_type& allocator) noexcept : allocator(allocator) {}
+
+            // Raw memory for count elements, the previous memory must have
+            // been released
+            constexpr T* acquire(size_type count) {
+                data_begin = count == 0 ? nullptr : allocator_traits::allocate(allocator, count);
+                capacity = count;
+                return data_begin;
+            }
+
+            constexpr void release_memory() noexcept {
+                if (data_begin != nullptr)
+                    allocator_traits::deallocate(allocator, data_begin, capacity);
+                data_begin = nullptr;
+                capacity = 0;
+            }
+
+            constexpr void swap_storage(dyn_array_storage& other) noexcept {
+                T* tmp_begin = data_begin;
+                size_type tmp_capacity = capacity;
+                data_begin = other.data_begin;
+                capacity = other.capacity;
+                other.data_begin = tmp_begin;
+                other.capacity = tmp_capacity;
+
+                allocator_type tmp_alloc = FTL_MOVE(allocator);
+                allocator = FTL_MOVE(other.allocator);
+                other.allocator = FTL_MOVE(tmp_alloc);
+            }
+
+            constexpr T* data() noexcept { return data_begin; }
+            constexpr const T* data() const noexcept { return data_begin; }
+
+            T*              data_begin  = nullptr;
+            size_type       capacity    = 0;
+            allocator_type  allocator;
+        };
+
+        // Elements inside the object, at most StaticSize of them
+        template <typename T, std::size_t StaticSize, std::size_t Alignment>
+        struct dyn_array_storage<T, ftl::static_storage<StaticSize, Alignment>>
+        {
+            using allocator_type    = void;
+            using size_type         = std::size_t;
+
+            constexpr static bool is_dynamic = false;
+            constexpr static size_type data_alignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+            constexpr dyn_array_storage() noexcept = default;
+            constexpr dyn_array_storage(const dyn_array_storage&) noexcept {}
+            constexpr dyn_array_storage(dyn_array_storage&&) noexcept {}
+
+            constexpr T* acquire(size_type count) {
+                if (count > StaticSize) {
+                    #ifdef __cpp_exceptions
+                        throw FTL_EXCEPT_DYN_ARRAY_TOO_LARGE;
+                    #endif
+                    assert(count <= StaticSize);
+                }
+                return data();
+            }
+
+            constexpr void release_memory() noexcept {}
+
+            T* data() noexcept { return std::launder(reinterpret_cast<T*>(store)); }
+            const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(store)); }
+
+            alignas(data_alignment) unsigned char store[sizeof(T) * StaticSize];
+        };
+    }
+
+    // Multi-dimensional array with extents given at run time, stored
+    // row-major in one contiguous block.  Storage is an allocator, e.g.
+    // ftl::aligned_allocator<T, 64> for aligned vector loads, or
+    // ftl::static_storage<N, Alignment> for at most N elements inside the
+    // object.  Changing the extents does not keep the elements.
+    template <typename T, std::size_t Rank, typename Storage = FTL_DEFAULT_ALLOCATOR>
+    class dyn_array
+    {
+        static_assert(Rank > 0);
+
+        using storage_type = detail::dyn_array_storage<T, Storage>;
+
+        public:
+            using value_type        = T;
+            using reference         = T&;
+            using const_reference   = const T&;
+            using size_type         = std::size_t;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = T*;
+            using const_pointer     = const T*;
+            using iterator          = T*;
+            using const_iterator    = const T*;
+            using allocator_type    = typename storage_type::allocator_type;
+
+            constexpr static size_type dimension = Rank;
+            constexpr static bool is_dynamic = storage_type::is_dynamic;
+
+            constexpr dyn_array() noexcept = default;
+
+            template <typename Allocator> requires (is_dynamic && std::same_as<Allocator, allocator_type>)
+            constexpr explicit dyn_array(const Allocator& allocator) noexcept
+                : storage(allocator) {}
+
+            // Value-initialised elements with the given extents
+            template <typename... Extents>
+                requires (sizeof...(Extents) == Rank && (std::is_convertible_v<Extents, size_type> && ...))
+            explicit dyn_array(Extents... extents) { create(extents...); }
+
+            template <typename Allocator, typename... Extents>
+                requires (is_dynamic && std::same_as<Allocator, allocator_type> && sizeof...(Extents) == Rank && (std::is_convertible_v<Extents, size_type> && ...))
+            dyn_array(const Allocator& allocator, Extents... extents) : storage(allocator) { create(extents...); }
+
+            dyn_array(const dyn_array& other)
+                : storage(copy_storage(other.storage))
+            {
+                copy_extents_from(other);
+                const_pointer source = other.data();
+                construct_elements(storage.acquire(element_count), element_count,
+                    [source](pointer p, size_type i) { ::new (static_cast<void*>(p)) T(source[i]); });
+            }
+
+            dyn_array(dyn_array&& other) noexcept(is_dynamic || std::is_nothrow_move_constructible_v<T>) {
+                take_contents(other);
+            }
+
+            dyn_array& operator=(const dyn_array& other) {
+                if (this == &other)
+                    return *this;
+
+                dyn_array copy(other);
+                *this = FTL_MOVE(copy);
+                return *this;
+            }
+
+            dyn_array& operator=(dyn_array&& other) noexcept(is_dynamic || std::is_nothrow_move_constructible_v<T>) {
+                if (this == &other)
+                    return *this;
+
+                clear();
+                storage.release_memory();
+                take_contents(other);
+                return *this;
+            }
+
+            ~dyn_array() {
+                clear();
+                storage.release_memory();
+            }
+
+            // element access
+            [[nodiscard]] constexpr reference operator[](size_type index) noexcept requires (Rank == 1) { return data()[index]; }
+            [[nodiscard]] constexpr const_reference operator[](size_type index) const noexcept requires (Rank == 1) { return data()[index]; }
+
+            template <typename... Index>
+                requires (sizeof...(Index) == Rank && (std::is_convertible_v<Index, size_type> && ...))
+            [[nodiscard]] constexpr reference at(Index... index) noexcept {
+                return data()[offset_of(index...)];
+            }
+
+            template <typename... Index>
+                requires (sizeof...(Index) == Rank && (std::is_convertible_v<Index, size_type> && ...))
+            [[nodiscard]] constexpr const_reference at(Index... index) const noexcept {
+                return data()[offset_of(index...)];
+            }
+
+            [[nodiscard]] constexpr reference front() noexcept                { return data()[0]; }
+            [[nodiscard]] constexpr const_reference front() const noexcept    { return data()[0]; }
+            [[nodiscard]] constexpr reference back() noexcept                 { return data()[size() - 1]; }
+            [[nodiscard]] constexpr const_reference back() const noexcept     { return data()[size() - 1]; }
+            [[nodiscard]] constexpr pointer data() noexcept                   { return storage.data(); }
+            [[nodiscard]] constexpr const_pointer data() const noexcept       { return storage.data(); }
+
+            // iterators
+            [[nodiscard]] constexpr iterator begin() noexcept { return data(); }
+            [[nodiscard]] constexpr iterator end() noexcept { return data() + size(); }
+            [[nodiscard]] constexpr const_iterator begin() const noexcept { return data(); }
+            [[nodiscard]] constexpr const_iterator end() const noexcept { return data() + size(); }
+
+            // capacity
+            [[nodiscard]] constexpr bool empty() const noexcept { return element_count == 0; }
+            [[nodiscard]] constexpr size_type size() const noexcept { return element_count; }
+            [[nodiscard]] constexpr size_type extent(size_type d) const noexcept { return extent_list[d]; }
+            [[nodiscard]] constexpr size_type byte_size() const noexcept { return size() * sizeof(T); }
+
+            // modifiers
+
+            // New value-initialised elements with the given extents, the
+            // memory is reused if the size stays the same
+            template <typename... Extents>
+                requires (sizeof...(Extents) == Rank && (std::is_convertible_v<Extents, size_type> && ...))
+            void resize(Extents... extents) {
+                const size_type count = (static_cast<size_type>(extents) * ...);
+                clear();
+                if (count != storage_capacity())
+                    storage.release_memory();
+                create(extents...);
+            }
+
+            // Destroys the elements and leaves all extents zero
+            void clear() noexcept {
+                if constexpr(not std::is_trivially_destructible_v<T>) {
+                    for (size_type i = 0; i < element_count; ++i)
+                        data()[i].~T();
+                }
+                element_count = 0;
+                for (size_type d = 0; d < Rank; ++d)
+                    extent_list[d] = 0;
+            }
+
+            void fill(const T& value) {
+                for (T& e : *this)
+                    e = value;
+            }
+
+            [[nodiscard]] allocator_type get_allocator() const noexcept requires is_dynamic { return storage.allocator; }
+
+        private:
+            template <typename... Extents>
+            void create(Extents... extents) {
+                const size_type count = (static_cast<size_type>(extents) * ...);
+                pointer target = (is_dynamic && count == storage_capacity()) ? data() : storage.acquire(count);
+                construct_elements(target, count, [](pointer p, size_type) { ::new (static_cast<void*>(p)) T(); });
+
+                const size_type extent_values[] = { static_cast<size_type>(extents)... };
+                for (size_type d = 0; d < Rank; ++d)
+                    extent_list[d] = extent_values[d];
+                element_count = count;
+            }
+
+            // Constructs count elements with construct(target + i, i).  If
+            // a constructor throws, the elements constructed so far are
+            // destroyed and the memory is released before it propagates.
+            template <typename Construct>
+            void construct_elements(pointer target, size_type count, const Construct& construct) {
+                struct unwind_guard
+                {
+                    ~unwind_guard() {
+                        if (constructed == count)
+                            return;
+                        if constexpr(not std::is_trivially_destructible_v<T>) {
+                            for (size_type i = 0; i < constructed; ++i)
+                                target[i].~T();
+                        }
+                        storage.release_memory();
+                    }
+
+                    storage_type&   storage;
+                    pointer         target;
+                    size_type       count;
+                    size_type       constructed;
+                } guard { storage, target, count, 0 };
+
+                for (; guard.constructed < count; ++guard.constructed)
+                    construct(target + guard.constructed, guard.constructed);
+            }
+
+            constexpr size_type storage_capacity() const noexcept {
+                if constexpr(is_dynamic)
+                    return storage.capacity;
+                else
+                    return 0;
+            }
+
+            // Horner's scheme over the extents, row-major
+            template <typename... Index>
+            constexpr size_type offset_of(Index... index) const noexcept {
+                const size_type indices[] = { static_cast<size_type>(index)... };
+                size_type offset = indices[0];
+                for (size_type d = 1; d < Rank; ++d)
+                    offset = offset * extent_list[d] + indices[d];
+                return offset;
+            }
+
+            // Leaves other empty, dynamic storage takes over the memory and
+            // static storage moves the elements.  This array must be empty,
+            // and stays empty if moving an element throws.
+            void take_contents(dyn_array& other) {
+                if constexpr(is_dynamic) {
+                    storage.swap_storage(other.storage);
+                    copy_extents_from(other);
+                } else {
+                    pointer source = other.data();
+                    construct_elements(data(), other.element_count,
+                        [source](pointer p, size_type i) { ::new (static_cast<void*>(p)) T(FTL_MOVE(source[i])); });
+                    copy_extents_from(other);
+                    other.clear();
+                }
+                other.element_count = 0;
+                for (size_type d = 0; d < Rank; ++d)
+                    other.extent_list[d] = 0;
+            }
+
+            void copy_extents_from(const dyn_array& other) noexcept {
+                for (size_type d = 0; d < Rank; ++d)
+                    extent_list[d] = other.extent_list[d];
+                element_count = other.element_count;
+            }
+
+            static storage_type copy_storage(const storage_type& other) {
+                if constexpr(is_dynamic)
+                    return storage_type(std::allocator_traits<Storage>::select_on_container_copy_construction(other.allocator));
+                else
+                    return storage_type();
+            }
+
+            storage_type    storage;
+            size_type       extent_list[Rank] = {};
+            size_type       element_count = 0;
+    };
+
+    template <typename T, std::size_t Rank, typename Storage>
+    bool operator==(const dyn_array<T, Rank, Storage>& lhs, const dyn_array<T, Rank, Storage>& rhs) {
+        for (std::size_t d = 0; d < Rank; ++d)
+            if (lhs.extent(d) != rhs.extent(d))
+                return false;
+
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+            if (lhs.data()[i] != rhs.data()[i])
+                return false;
+
+        return true;
+    }
+}
+
+#endif
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
@@ -4,6 +4,12 @@
 #include <cstdint>
 #include <type_traits>
 
+#if defined(__AVX2__)
+# include <immintrin.h>
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+
 namespace ftl
 {
     struct hash_fnv1a
@@ -24,6 +30,244 @@ namespace ftl
             return hval;
         }
     };
+
+    namespace detail {
+        constexpr uint64_t splitmix64(uint64_t& state) noexcept {
+            uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+        struct hash_secret
+        {
+            alignas(64) uint8_t bytes[192];
+        };
+
+        constexpr hash_secret make_hash_secret() noexcept {
+            hash_secret secret = {};
+            uint64_t state = 0x243f6a8885a308d3ULL;
+            for (std::size_t i = 0; i < sizeof(secret.bytes); i += 8) {
+                const uint64_t word = splitmix64(state);
+                for (std::size_t b = 0; b < 8; ++b)
+                    secret.bytes[i + b] = static_cast<uint8_t>(word >> (8 * b));
+            }
+            return secret;
+        }
+
+        inline constexpr hash_secret hash_fast64_secret = make_hash_secret();
+    }
+
+    // Reads eight bytes at a time.  Inputs up to 256 bytes use wyhash's
+    // 128-bit multiply-and-fold, longer ones XXH3's scheme of eight 64-bit
+    // accumulators fed 64-byte stripes with 32x32-bit multiplies, which map
+    // onto SSE2 and AVX2 when the target has them.  Every path gives the
+    // same result, also on big-endian targets, but the values are not those
+    // of wyhash or XXH3.
+    struct hash_fast64
+    {
+        static uint64_t hash64(const uint8_t* ptr, std::size_t byte_count) noexcept {
+            if (byte_count > long_input)
+                return hash_long(ptr, byte_count);
+            return hash_short(ptr, byte_count);
+        }
+
+        private:
+            constexpr static uint64_t wy0 = 0x2d358dccaa6c78a5ULL;
+            constexpr static uint64_t wy1 = 0x8bb84b93962eacc9ULL;
+            constexpr static uint64_t wy2 = 0x4b33a62ed433d4a3ULL;
+            constexpr static uint64_t wy3 = 0x4d5a2da51de1aa47ULL;
+
+            constexpr static uint64_t prime32_1 = 0x9e3779b1ULL;
+            constexpr static uint64_t prime32_2 = 0x85ebca77ULL;
+            constexpr static uint64_t prime32_3 = 0xc2b2ae3dULL;
+            constexpr static uint64_t prime64_1 = 0x9e3779b185ebca87ULL;
+            constexpr static uint64_t prime64_2 = 0xc2b2ae3d27d4eb4fULL;
+            constexpr static uint64_t prime64_3 = 0x165667b19e3779f9ULL;
+            constexpr static uint64_t prime64_4 = 0x85ebca77c2b2ae63ULL;
+            constexpr static uint64_t prime64_5 = 0x27d4eb2f165667c5ULL;
+
+            constexpr static std::size_t long_input = 256;
+            constexpr static std::size_t stripe_size = 64;
+            constexpr static std::size_t secret_size = sizeof(detail::hash_secret::bytes);
+            constexpr static std::size_t stripes_per_block = (secret_size - stripe_size) / 8;
+            constexpr static std::size_t block_size = stripe_size * stripes_per_block;
+
+            static uint64_t read64(const uint8_t* ptr) noexcept {
+                uint64_t value;
+                __builtin_memcpy(&value, ptr, sizeof(value));
+                #if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                value = __builtin_bswap64(value);
+                #endif
+                return value;
+            }
+
+            static uint64_t read32(const uint8_t* ptr) noexcept {
+                uint32_t value;
+                __builtin_memcpy(&value, ptr, sizeof(value));
+                #if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                value = __builtin_bswap32(value);
+                #endif
+                return value;
+            }
+
+            // a, b = low and high halves of a * b
+            static void multiply(uint64_t& a, uint64_t& b) noexcept {
+                #ifdef __SIZEOF_INT128__
+                __extension__ using uint128 = unsigned __int128;
+                const uint128 product = static_cast<uint128>(a) * b;
+                a = static_cast<uint64_t>(product);
+                b = static_cast<uint64_t>(product >> 64);
+                #else
+                const uint64_t a_hi = a >> 32, a_lo = static_cast<uint32_t>(a);
+                const uint64_t b_hi = b >> 32, b_lo = static_cast<uint32_t>(b);
+                const uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo;
+                const uint64_t lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+                const uint64_t cross = (lo_lo >> 32) + static_cast<uint32_t>(hi_lo) + lo_hi;
+                a = (cross << 32) | static_cast<uint32_t>(lo_lo);
+                b = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+                #endif
+            }
+
+            static uint64_t mix(uint64_t a, uint64_t b) noexcept {
+                multiply(a, b);
+                return a ^ b;
+            }
+
+            static uint64_t hash_short(const uint8_t* ptr, std::size_t byte_count) noexcept {
+                uint64_t seed = mix(wy0, wy1);
+                uint64_t a = 0;
+                uint64_t b = 0;
+
+                if (byte_count <= 16) {
+                    if (byte_count >= 4) {
+                        const std::size_t middle = (byte_count >> 3) << 2;
+                        a = (read32(ptr) << 32) | read32(ptr + middle);
+                        b = (read32(ptr + byte_count - 4) << 32) | read32(ptr + byte_count - 4 - middle);
+                    } else if (byte_count > 0) {
+                        a = (uint64_t(ptr[0]) << 16) | (uint64_t(ptr[byte_count >> 1]) << 8) | ptr[byte_count - 1];
+                    }
+                } else {
+                    std::size_t remaining = byte_count;
+                    const uint8_t* p = ptr;
+                    if (remaining > 48) {
+                        uint64_t lane1 = seed;
+                        uint64_t lane2 = seed;
+                        do {
+                            seed = mix(read64(p) ^ wy1, read64(p + 8) ^ seed);
+                            lane1 = mix(read64(p + 16) ^ wy2, read64(p + 24) ^ lane1);
+                            lane2 = mix(read64(p + 32) ^ wy3, read64(p + 40) ^ lane2);
+                            p += 48;
+                            remaining -= 48;
+                        } while (remaining > 48);
+                        seed ^= lane1 ^ lane2;
+                    }
+
+                    while (remaining > 16) {
+                        seed = mix(read64(p) ^ wy1, read64(p + 8) ^ seed);
+                        p += 16;
+                        remaining -= 16;
+                    }
+
+                    a = read64(p + remaining - 16);
+                    b = read64(p + remaining - 8);
+                }
+
+                a ^= wy1;
+                b ^= seed;
+                multiply(a, b);
+                return mix(a ^ wy0 ^ byte_count, b ^ wy1);
+            }
+
+            // acc[i] += low * high half of (input ^ key)[i], acc[i ^ 1] += input[i]
+            static void accumulate_stripe(uint64_t* acc, const uint8_t* input, const uint8_t* key) noexcept {
+                #if defined(__AVX2__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                __m256i* vacc = reinterpret_cast<__m256i*>(acc);
+                for (std::size_t i = 0; i < stripe_size / sizeof(__m256i); ++i) {
+                    const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input) + i);
+                    const __m256i data_key = _mm256_xor_si256(data, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key) + i));
+                    const __m256i product = _mm256_mul_epu32(data_key, _mm256_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+                    const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                    vacc[i] = _mm256_add_epi64(vacc[i], _mm256_add_epi64(product, swapped));
+                }
+                #elif defined(__SSE2__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                __m128i* vacc = reinterpret_cast<__m128i*>(acc);
+                for (std::size_t i = 0; i < stripe_size / sizeof(__m128i); ++i) {
+                    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input) + i);
+                    const __m128i data_key = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key) + i));
+                    const __m128i product = _mm_mul_epu32(data_key, _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+                    const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                    vacc[i] = _mm_add_epi64(vacc[i], _mm_add_epi64(product, swapped));
+                }
+                #else
+                for (std::size_t i = 0; i < 8; ++i) {
+                    const uint64_t data = read64(input + 8 * i);
+                    const uint64_t data_key = data ^ read64(key + 8 * i);
+                    acc[i ^ 1] += data;
+                    acc[i] += (data_key & 0xffffffffULL) * (data_key >> 32);
+                }
+                #endif
+            }
+
+            // acc[i] = (acc[i] ^ acc[i] >> 47 ^ key[i]) * prime32_1
+            static void scramble(uint64_t* acc, const uint8_t* key) noexcept {
+                #if defined(__AVX2__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                __m256i* vacc = reinterpret_cast<__m256i*>(acc);
+                const __m256i prime = _mm256_set1_epi32(static_cast<int>(prime32_1));
+                for (std::size_t i = 0; i < stripe_size / sizeof(__m256i); ++i) {
+                    __m256i value = _mm256_xor_si256(vacc[i], _mm256_srli_epi64(vacc[i], 47));
+                    value = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key) + i));
+                    const __m256i low = _mm256_mul_epu32(value, prime);
+                    const __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), prime);
+                    vacc[i] = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+                }
+                #elif defined(__SSE2__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                __m128i* vacc = reinterpret_cast<__m128i*>(acc);
+                const __m128i prime = _mm_set1_epi32(static_cast<int>(prime32_1));
+                for (std::size_t i = 0; i < stripe_size / sizeof(__m128i); ++i) {
+                    __m128i value = _mm_xor_si128(vacc[i], _mm_srli_epi64(vacc[i], 47));
+                    value = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key) + i));
+                    const __m128i low = _mm_mul_epu32(value, prime);
+                    const __m128i high = _mm_mul_epu32(_mm_srli_epi64(value, 32), prime);
+                    vacc[i] = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+                }
+                #else
+                for (std::size_t i = 0; i < 8; ++i) {
+                    const uint64_t value = acc[i] ^ (acc[i] >> 47) ^ read64(key + 8 * i);
+                    acc[i] = value * prime32_1;
+                }
+                #endif
+            }
+
+            static uint64_t hash_long(const uint8_t* ptr, std::size_t byte_count) noexcept {
+                const uint8_t* secret = detail::hash_fast64_secret.bytes;
+                alignas(32) uint64_t acc[8] = {
+                    prime32_3, prime64_1, prime64_2, prime64_3, prime64_4, prime32_2, prime64_5, prime32_1
+                };
+
+                const std::size_t blocks = (byte_count - 1) / block_size;
+                for (std::size_t block = 0; block < blocks; ++block) {
+                    const uint8_t* input = ptr + block * block_size;
+                    for (std::size_t stripe = 0; stripe < stripes_per_block; ++stripe)
+                        accumulate_stripe(acc, input + stripe * stripe_size, secret + stripe * 8);
+                    scramble(acc, secret + secret_size - stripe_size);
+                }
+
+                // the rest of the stripes, and the last 64 bytes with their own key
+                const std::size_t stripes = (byte_count - 1 - blocks * block_size) / stripe_size;
+                for (std::size_t stripe = 0; stripe < stripes; ++stripe)
+                    accumulate_stripe(acc, ptr + blocks * block_size + stripe * stripe_size, secret + stripe * 8);
+                accumulate_stripe(acc, ptr + byte_count - stripe_size, secret + secret_size - stripe_size - 7);
+
+                uint64_t result = byte_count * prime64_1;
+                for (std::size_t i = 0; i < 4; ++i)
+                    result += mix(acc[2 * i] ^ read64(secret + 11 + 16 * i), acc[2 * i + 1] ^ read64(secret + 19 + 16 * i));
+
+                result ^= result >> 37;
+                result *= prime64_3;
+                return result ^ (result >> 32);
+            }
+    };
 }
 
 namespace ftl
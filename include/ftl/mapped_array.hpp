@@ -0,0 +1,273 @@
+#ifndef FTL_MAPPED_ARRAY_HPP
+#define FTL_MAPPED_ARRAY_HPP
+
+// Needs files and mmap, so this header is empty in freestanding
+// environments and where POSIX mmap is not available.
+#if __STDC_HOSTED__ == 1 && __has_include(<sys/mman.h>)
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "utility.hpp"
+#include "array.hpp"
+
+namespace ftl
+{
+    // Files written by write_binary start with this header, followed by
+    // rank 64-bit extents and, from data_offset, the elements as they are
+    // in memory.  data_offset is a multiple of 64 so the mapped elements are
+    // aligned for any element type.
+    struct mapped_array_header
+    {
+        constexpr static char magic_value[8] = { 'F', 'T', 'L', 'A', 'R', 'R', 'A', 'Y' };
+        constexpr static uint32_t byte_order_value = 0x01020304;
+        constexpr static uint64_t data_alignment = 64;
+
+        char        magic[8];
+        uint32_t    byte_order;         // byte_order_value as written by the writer
+        uint32_t    element_size;
+        uint64_t    rank;
+        uint64_t    data_offset;
+
+        constexpr static uint64_t data_offset_for(uint64_t rank) noexcept {
+            const uint64_t end = sizeof(mapped_array_header) + rank * sizeof(uint64_t);
+            return (end + data_alignment - 1) / data_alignment * data_alignment;
+        }
+    };
+
+    enum class mapped_array_error
+    {
+        none,
+        open_failed,
+        map_failed,
+        bad_header,         // not written by write_binary, or truncated
+        byte_order,         // written on a machine of the other endianness
+        element_size,
+        extents,
+    };
+
+    // Read-only view of an ftl::array stored in a file by write_binary.  The
+    // file is mapped, nothing is read or copied up front and pages are loaded
+    // as they are first touched.  get() gives the mapped data as a const
+    // ftl::array, so all of its read API, views and element-wise operations
+    // work on it directly.
+    //
+    // Opening does not throw, check is_open() or error() afterwards.
+    template <typename T, std::size_t... Dimensions>
+    class mapped_array
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be mapped");
+
+        public:
+            using array_type        = ftl::array<T, Dimensions...>;
+            using value_type        = T;
+            using size_type         = std::size_t;
+            using const_reference   = const T&;
+            using const_pointer     = const T*;
+            using const_iterator    = const T*;
+
+            static_assert(array_type::storage_size() == array_type::size());
+
+            constexpr mapped_array() noexcept = default;
+
+            explicit mapped_array(const char* path) noexcept { open(path); }
+
+            mapped_array(const mapped_array&) = delete;
+            mapped_array& operator=(const mapped_array&) = delete;
+
+            mapped_array(mapped_array&& other) noexcept
+                : mapping(other.mapping), mapping_size(other.mapping_size), array_ptr(other.array_ptr), open_error(other.open_error)
+            {
+                other.forget();
+            }
+
+            mapped_array& operator=(mapped_array&& other) noexcept {
+                if (this == &other)
+                    return *this;
+
+                close();
+                mapping = other.mapping;
+                mapping_size = other.mapping_size;
+                array_ptr = other.array_ptr;
+                open_error = other.open_error;
+                other.forget();
+                return *this;
+            }
+
+            ~mapped_array() { close(); }
+
+            // Unmaps the current file, if any, and maps the one at path
+            bool open(const char* path) noexcept {
+                close();
+
+                const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+                if (fd < 0)
+                    return fail(mapped_array_error::open_failed);
+
+                struct stat info;
+                if (::fstat(fd, &info) != 0) {
+                    ::close(fd);
+                    return fail(mapped_array_error::open_failed);
+                }
+
+                if (static_cast<uint64_t>(info.st_size) < sizeof(mapped_array_header)) {
+                    ::close(fd);
+                    return fail(mapped_array_error::bad_header);
+                }
+
+                mapping_size = static_cast<std::size_t>(info.st_size);
+                void* address = ::mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+
+                if (address == MAP_FAILED) {
+                    mapping_size = 0;
+                    return fail(mapped_array_error::map_failed);
+                }
+
+                mapping = address;
+                const mapped_array_error status = check_contents();
+                if (status != mapped_array_error::none) {
+                    close();
+                    return fail(status);
+                }
+
+                const auto& header = *static_cast<const mapped_array_header*>(mapping);
+                array_ptr = std::launder(reinterpret_cast<const array_type*>(static_cast<const unsigned char*>(mapping) + header.data_offset));
+                return true;
+            }
+
+            void close() noexcept {
+                if (mapping != nullptr)
+                    ::munmap(mapping, mapping_size);
+                forget();
+            }
+
+            [[nodiscard]] bool is_open() const noexcept { return array_ptr != nullptr; }
+            [[nodiscard]] mapped_array_error error() const noexcept { return open_error; }
+
+            // The mapped data, only valid while the file is open
+            [[nodiscard]] const array_type& get() const noexcept { return *array_ptr; }
+            [[nodiscard]] const array_type& operator*() const noexcept { return *array_ptr; }
+            [[nodiscard]] const array_type* operator->() const noexcept { return array_ptr; }
+
+            // element access
+            template <typename... Index>
+            [[nodiscard]] const_reference at(Index... index) const noexcept { return array_ptr->at(index...); }
+
+            [[nodiscard]] decltype(auto) operator[](size_type index) const noexcept { return (*array_ptr)[index]; }
+
+            [[nodiscard]] const_pointer data() const noexcept { return array_ptr->data(); }
+            [[nodiscard]] const_iterator begin() const noexcept { return array_ptr->begin(); }
+            [[nodiscard]] const_iterator end() const noexcept { return array_ptr->end(); }
+
+            // capacity
+            [[nodiscard]] constexpr static size_type size() noexcept { return array_type::size(); }
+            [[nodiscard]] constexpr static size_type extent(size_type d) noexcept { return array_type::extent(d); }
+
+        private:
+            mapped_array_error check_contents() const noexcept {
+                const auto& header = *static_cast<const mapped_array_header*>(mapping);
+                if (memcmp(header.magic, mapped_array_header::magic_value, sizeof(header.magic)) != 0)
+                    return mapped_array_error::bad_header;
+
+                if (header.byte_order != mapped_array_header::byte_order_value)
+                    return header.byte_order == __builtin_bswap32(mapped_array_header::byte_order_value)
+                         ? mapped_array_error::byte_order : mapped_array_error::bad_header;
+
+                if (header.element_size != sizeof(T))
+                    return mapped_array_error::element_size;
+
+                if (header.rank != sizeof...(Dimensions))
+                    return mapped_array_error::extents;
+
+                if (header.data_offset != mapped_array_header::data_offset_for(header.rank)
+                    || mapping_size < header.data_offset + sizeof(array_type))
+                    return mapped_array_error::bad_header;
+
+                const uint64_t* extents = reinterpret_cast<const uint64_t*>(&header + 1);
+                for (std::size_t d = 0; d < sizeof...(Dimensions); ++d)
+                    if (extents[d] != array_type::extent(d))
+                        return mapped_array_error::extents;
+
+                return mapped_array_error::none;
+            }
+
+            bool fail(mapped_array_error status) noexcept {
+                open_error = status;
+                return false;
+            }
+
+            void forget() noexcept {
+                mapping = nullptr;
+                mapping_size = 0;
+                array_ptr = nullptr;
+                open_error = mapped_array_error::none;
+            }
+
+            void*                   mapping         = nullptr;
+            std::size_t             mapping_size    = 0;
+            const array_type*       array_ptr       = nullptr;
+            mapped_array_error      open_error      = mapped_array_error::none;
+    };
+
+    // Writes the array to path in the format mapped_array reads, replacing
+    // the file if it exists.  Returns false if the file could not be written.
+    template <typename T, std::size_t... Dimensions>
+    bool write_binary(const array<T, Dimensions...>& source, const char* path) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be written");
+
+        mapped_array_header header = {};
+        memcpy(header.magic, mapped_array_header::magic_value, sizeof(header.magic));
+        header.byte_order = mapped_array_header::byte_order_value;
+        header.element_size = sizeof(T);
+        header.rank = sizeof...(Dimensions);
+        header.data_offset = mapped_array_header::data_offset_for(header.rank);
+
+        const uint64_t extents[] = { Dimensions... };
+        const unsigned char padding[mapped_array_header::data_alignment] = {};
+        const std::size_t padding_size = header.data_offset - sizeof(header) - sizeof(extents);
+
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr)
+            return false;
+
+        bool written = fwrite(&header, sizeof(header), 1, file) == 1
+                    && fwrite(extents, sizeof(extents), 1, file) == 1
+                    && (padding_size == 0 || fwrite(padding, padding_size, 1, file) == 1)
+                    && fwrite(source.data(), source.byte_size(), 1, file) == 1;
+
+        written = fclose(file) == 0 && written;
+        return written;
+    }
+}
+
+#endif
+#endif
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
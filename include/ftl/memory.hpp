@@ -5,6 +5,10 @@
 #include <type_traits>
 #include <concepts>
 
+#if __STDC_HOSTED__ == 1
+# include <new>
+#endif
+
 #if __STDC_HOSTED__ == 1
 # define FTL_DEFAULT_ALLOCATOR std::allocator<T>
 #else
@@ -19,11 +23,22 @@ namespace std {
 
 namespace ftl
 {
-    template <std::size_t StorageBytes>
+    // Assumed size of a cache line, used as the unit for padding when
+    // separating data that is written from different threads
+    constexpr static std::size_t cache_line_size = 64;
+
+    // Alignment of 0 lays the storage out as compactly as possible.  A non-zero
+    // alignment aligns the start of the data to it and places each piece of
+    // bookkeeping written independently (e.g. read and write heads) at its own
+    // multiple of it, so with cache_line_size they never share a line with the
+    // data, each other or a neighbouring container.
+    template <std::size_t StorageBytes, std::size_t Alignment = 0>
     struct static_storage
     {
         static_assert(StorageBytes != 0);
+        static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
         constexpr static std::size_t size = StorageBytes;
+        constexpr static std::size_t alignment = Alignment;
     };
 
     template<typename, typename = void> [[maybe_unused]]
@@ -73,6 +88,42 @@ namespace ftl
     concept any_good_enough_allocator = any_with_required_allocator_traits<T> || suitable_raw_allocator<T>;
 }
 
+#if __STDC_HOSTED__ == 1
+namespace ftl
+{
+    // std::allocator that aligns every allocation to Alignment, e.g. to
+    // cache_line_size or the width of the widest vector registers
+    template <typename T, std::size_t Alignment>
+    struct aligned_allocator
+    {
+        static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+        static_assert(Alignment >= alignof(T), "Alignment must be at least that of the type");
+
+        using value_type = T;
+        constexpr static std::size_t alignment = Alignment;
+
+        template <typename U>
+        struct rebind { using other = aligned_allocator<U, Alignment>; };
+
+        constexpr aligned_allocator() noexcept = default;
+
+        template <typename U>
+        constexpr aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
+
+        [[nodiscard]] T* allocate(std::size_t count) {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+        }
+
+        void deallocate(T* ptr, std::size_t count) noexcept {
+            ::operator delete(static_cast<void*>(ptr), count * sizeof(T), std::align_val_t(Alignment));
+        }
+
+        template <typename U>
+        constexpr bool operator==(const aligned_allocator<U, Alignment>&) const noexcept { return true; }
+    };
+}
+#endif
+
 #endif
 /*
     Copyright 2022 Jari Ronkainen
@@ -3,6 +3,8 @@
 
 #include <type_traits>
 #include <new>
+#include <utility>
+#include <string.h>
 
 #include "memory.hpp"
 #include "utility.hpp"
@@ -24,6 +26,232 @@
 
 namespace ftl
 {
+    // Contiguous run of elements inside a ring buffer's storage
+    template <typename T>
+    struct ring_buffer_segment
+    {
+        using value_type        = std::remove_cv_t<T>;
+        using size_type         = std::size_t;
+        using pointer           = T*;
+        using reference         = T&;
+        using iterator          = T*;
+
+        pointer     ptr         = nullptr;
+        size_type   count       = 0;
+
+        [[nodiscard]] constexpr pointer data() const noexcept { return ptr; }
+        [[nodiscard]] constexpr size_type size() const noexcept { return count; }
+        [[nodiscard]] constexpr bool empty() const noexcept { return count == 0; }
+
+        [[nodiscard]] constexpr iterator begin() const noexcept { return ptr; }
+        [[nodiscard]] constexpr iterator end() const noexcept { return ptr + count; }
+
+        [[nodiscard]] constexpr reference operator[](size_type index) const noexcept { return ptr[index]; }
+    };
+
+    // Buffer contents in order as at most two contiguous segments, the
+    // second one is empty unless the contents wrap around the storage end.
+    template <typename T>
+    struct ring_buffer_segments
+    {
+        ring_buffer_segment<T> first;
+        ring_buffer_segment<T> second;
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return first.size() + second.size(); }
+        [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+
+        [[nodiscard]] constexpr T& operator[](std::size_t index) const noexcept {
+            return index < first.size() ? first[index] : second[index - first.size()];
+        }
+    };
+
+    // Shrink policies are asked before each push and pop of an allocator-backed
+    // ring buffer, and return the capacity the buffer should have.  Anything
+    // smaller than the current capacity reallocates, never below size().
+    struct never_shrink
+    {
+        constexpr std::size_t operator()(std::size_t, std::size_t capacity) const noexcept { return capacity; }
+    };
+
+    // Halves the capacity once the buffer has stayed under Percent % full for
+    // Operations pushes and pops in a row, but never below MinCapacity.
+    template <std::size_t Percent = 25, std::size_t Operations = 64, std::size_t MinCapacity = 8>
+    struct hysteresis_shrink
+    {
+        static_assert(Percent <= 50, "shrinking above half full would grow again right away");
+
+        std::size_t low_count = 0;
+
+        constexpr std::size_t operator()(std::size_t size, std::size_t capacity) noexcept {
+            if (capacity <= MinCapacity || size * 100 >= capacity * Percent) {
+                low_count = 0;
+                return capacity;
+            }
+
+            if (++low_count < Operations)
+                return capacity;
+
+            low_count = 0;
+            return capacity / 2 > MinCapacity ? capacity / 2 : MinCapacity;
+        }
+    };
+
+    // Capacity roundings for geometric_growth, given the capacity and element
+    // size they return the capacity to allocate, which is never smaller
+    struct exact_capacity
+    {
+        constexpr std::size_t operator()(std::size_t capacity, std::size_t) const noexcept { return capacity; }
+    };
+
+    struct round_to_power_of_two
+    {
+        constexpr std::size_t operator()(std::size_t capacity, std::size_t) const noexcept {
+            std::size_t rounded = 1;
+            while (rounded < capacity && rounded <= (~std::size_t{0} >> 1))
+                rounded <<= 1;
+            return rounded < capacity ? capacity : rounded;
+        }
+    };
+
+    // Fills whole pages, 4 KiB by default or e.g. 2 MiB for huge pages
+    template <std::size_t PageSize = 4096>
+    struct round_to_pages
+    {
+        static_assert(PageSize != 0);
+
+        constexpr std::size_t operator()(std::size_t capacity, std::size_t element_size) const noexcept {
+            if (capacity > (~std::size_t{0} - PageSize) / element_size)
+                return capacity;
+
+            const std::size_t bytes = (capacity * element_size + PageSize - 1) / PageSize * PageSize;
+            return bytes / element_size;
+        }
+    };
+
+    // Growth policies are asked when an allocator-backed ring buffer needs room
+    // for required elements, and return the new capacity.  Returning less than
+    // required means the buffer is at its maximum and behaves as if static.
+    //
+    // Starts at InitialCapacity and multiplies the capacity by Numerator / Denominator,
+    // so 3 / 2 gives 1.5x growth, then rounds the result and clamps it to MaxCapacity.
+    template <std::size_t InitialCapacity = 8,
+              std::size_t Numerator = 2,
+              std::size_t Denominator = 1,
+              typename Rounding = exact_capacity,
+              std::size_t MaxCapacity = ~std::size_t{0}>
+    struct geometric_growth
+    {
+        static_assert(Numerator > Denominator && Denominator != 0, "growth factor has to be more than one");
+        static_assert(InitialCapacity != 0 && InitialCapacity <= MaxCapacity);
+
+        constexpr std::size_t operator()(std::size_t capacity, std::size_t required, std::size_t element_size) const noexcept {
+            std::size_t target = InitialCapacity;
+            if (capacity != 0) {
+                target = capacity > MaxCapacity / Numerator
+                    ? MaxCapacity
+                    : capacity * Numerator / Denominator;
+            }
+
+            if (target <= capacity)
+                target = capacity + 1;
+            if (target < required)
+                target = required;
+
+            target = Rounding{}(target, element_size);
+            return target > MaxCapacity ? MaxCapacity : target;
+        }
+    };
+
+    // Observers are told the old and new size and the capacity after every
+    // push, pop, clear() and transfer_from() that changes the size of a ring
+    // buffer, and how many elements push_overwrite() dropped.  They must not
+    // modify the buffer they observe.
+    struct no_observer
+    {
+        constexpr void size_changed(std::size_t, std::size_t, std::size_t) noexcept {}
+        constexpr void overwritten(std::size_t) noexcept {}
+    };
+
+    enum class ring_buffer_event
+    {
+        high_watermark,     // size rose to the high watermark, the argument is the size
+        low_watermark,      // size fell back to the low watermark, the argument is the size
+        overwrite,          // push_overwrite() dropped elements, the argument is their count
+    };
+
+    struct no_watermark_callback
+    {
+        constexpr void operator()(ring_buffer_event, std::size_t) const noexcept {}
+    };
+
+    // Back-pressure for producers: is_throttled() turns on when the size reaches
+    // the high watermark and off when it falls back to the low watermark, and
+    // Callback is called on both crossings.  Also counts dropped elements.
+    // If Callback may throw, clear() and push_overwrite() may throw too.
+    template <typename Callback = no_watermark_callback>
+    class watermark_observer
+    {
+        public:
+            constexpr watermark_observer() = default;
+            constexpr watermark_observer(std::size_t low, std::size_t high, Callback callback = Callback{})
+                : callback(FTL_MOVE(callback)) { set_watermarks(low, high); }
+
+            constexpr void set_watermarks(std::size_t low, std::size_t high) noexcept {
+                assert(low < high);
+                low_mark = low;
+                high_mark = high;
+            }
+
+            constexpr void set_callback(Callback new_callback) { callback = FTL_MOVE(new_callback); }
+
+            [[nodiscard]] constexpr bool is_throttled() const noexcept { return throttled; }
+            [[nodiscard]] constexpr std::size_t low_watermark() const noexcept { return low_mark; }
+            [[nodiscard]] constexpr std::size_t high_watermark() const noexcept { return high_mark; }
+            [[nodiscard]] constexpr std::size_t dropped() const noexcept { return dropped_count; }
+
+            constexpr static bool nothrow_callback = std::is_nothrow_invocable_v<Callback&, ring_buffer_event, std::size_t>;
+
+            constexpr void size_changed(std::size_t, std::size_t size, std::size_t) noexcept(nothrow_callback) {
+                if (not throttled && size >= high_mark) {
+                    throttled = true;
+                    notify(ring_buffer_event::high_watermark, size);
+                } else if (throttled && size <= low_mark) {
+                    throttled = false;
+                    notify(ring_buffer_event::low_watermark, size);
+                }
+            }
+
+            constexpr void overwritten(std::size_t count) noexcept(nothrow_callback) {
+                dropped_count += count;
+                notify(ring_buffer_event::overwrite, count);
+            }
+
+        private:
+            constexpr void notify(ring_buffer_event event, std::size_t value) noexcept(nothrow_callback) {
+                // function pointers and std::function may be empty
+                if constexpr(std::is_pointer_v<Callback> || requires(const Callback& cb) { cb.operator bool(); }) {
+                    if (not callback)
+                        return;
+                }
+                callback(event, value);
+            }
+
+            std::size_t low_mark        = 0;
+            std::size_t high_mark       = ~std::size_t{0};
+            std::size_t dropped_count   = 0;
+            bool        throttled       = false;
+
+            [[no_unique_address]] Callback callback{};
+    };
+
+    // Tunables of a ring buffer, derive from this and override what you need
+    struct default_ring_buffer_policy
+    {
+        using shrink_policy = never_shrink;
+        using growth_policy = geometric_growth<>;
+        using observer      = no_observer;
+    };
+
     namespace detail {
         // for providing decent-ish error message if allocator wasn't good enough
         template <ftl::any_good_enough_allocator T>
@@ -58,24 +286,25 @@ namespace ftl
                 constexpr static bool   is_dynamic = true;
 
                 constexpr ring_buffer_storage() noexcept = default;
+
+                // Copies only the allocator, elements are copied by ring_buffer_details
+                constexpr ring_buffer_storage(const ring_buffer_storage& other) noexcept : allocator(other.allocator) {}
+                constexpr ring_buffer_storage(ring_buffer_storage&& other) noexcept : allocator(other.allocator) { swap_storage(other); }
+
+                ring_buffer_storage& operator=(const ring_buffer_storage&) = delete;
+                ring_buffer_storage& operator=(ring_buffer_storage&&) = delete;
                 constexpr ~ring_buffer_storage() {
                     if (data_begin == nullptr)
                         return;
 
                     if constexpr(not std::is_trivially_destructible_v<value_type>) {
-                        if (read_head == nullptr)
-                            return;
-
-                        if (write_head == nullptr)
-                            write_head = read_head == data() + get_capacity() - 1 ? data() : read_head + 1;
-
-                        while(write_head != read_head) {
+                        for (size_type count = get_size(); count != 0; --count) {
                             get_read_head()->~T();
                             advance_read_head();
                         }
                     }
 
-                    allocator.deallocate(data_begin, get_size());
+                    allocator.deallocate(data_begin, get_capacity());
                 };
 
                 constexpr inline bool is_empty() const noexcept { return (write_head == read_head) || read_head == nullptr; }
@@ -102,27 +331,67 @@ namespace ftl
                     if (new_size <= get_capacity())
                         return;
 
-                    pointer old_data_begin = data_begin;
-                    pointer new_data_ptr = allocator.allocate(new_size);
+                    reallocate(new_size);
+                }
 
-                    size_t it = 0;
-                    if (old_data_begin != nullptr) {
-                        while (read_head != write_head) {
-                            if constexpr(std::is_move_assignable_v<T>)
-                                new_data_ptr[it++] = static_cast<T&&>(*read_head);
-                            else 
-                                new_data_ptr[it++] = *read_head;
-                            advance_read_head();
-                        }
+                // Moves the elements to a new allocation of exactly new_size elements,
+                // which must be able to hold them.  Zero frees the storage.
+                constexpr void reallocate(size_type new_size) {
+                    const size_type count = get_size();
+                    assert(new_size >= count);
+
+                    if (new_size == get_capacity() && (read_head == data_begin || count == 0))
+                        return;
+
+                    pointer new_data_ptr = new_size == 0 ? nullptr : allocator.allocate(new_size);
+
+                    for (size_type it = 0; it < count; ++it) {
+                        if constexpr(std::is_move_constructible_v<T>)
+                            ::new (static_cast<void*>(new_data_ptr + it)) T(static_cast<T&&>(*read_head));
+                        else
+                            ::new (static_cast<void*>(new_data_ptr + it)) T(*read_head);
+
+                        if constexpr(not std::is_trivially_destructible_v<T>)
+                            read_head->~T();
+                        advance_read_head();
                     }
+
+                    if (data_begin != nullptr)
+                        allocator.deallocate(data_begin, get_capacity());
+
                     data_begin = new_data_ptr;
                     data_end = new_data_ptr + new_size;
 
                     read_head = data_begin;
-                    write_head = data_begin + it;
+                    write_head = count == new_size ? nullptr : data_begin + count;
+                }
+
+                // Exchanges the allocations of two buffers without touching the elements
+                constexpr void swap_storage(ring_buffer_storage& other) noexcept {
+                    pointer tmp_read = read_head, tmp_write = write_head, tmp_begin = data_begin, tmp_end = data_end;
+                    read_head = other.read_head; write_head = other.write_head;
+                    data_begin = other.data_begin; data_end = other.data_end;
+                    other.read_head = tmp_read; other.write_head = tmp_write;
+                    other.data_begin = tmp_begin; other.data_end = tmp_end;
+
+                    allocator_type tmp_alloc = FTL_MOVE(allocator);
+                    allocator = FTL_MOVE(other.allocator);
+                    other.allocator = FTL_MOVE(tmp_alloc);
+                }
+
+                [[nodiscard]] constexpr bool has_equal_allocator(const ring_buffer_storage& other) const noexcept {
+                    if constexpr(requires { typename allocator_traits::is_always_equal; }) {
+                        if constexpr(allocator_traits::is_always_equal::value)
+                            return true;
+                    }
+                    if constexpr(requires { { allocator == other.allocator } -> std::convertible_to<bool>; })
+                        return allocator == other.allocator;
+                    else
+                        return false;
                 }
 
                 constexpr pointer data() noexcept { return data_begin; }
+                constexpr const T* data() const noexcept { return data_begin; }
                 constexpr size_type get_capacity() const noexcept { return (data_end - data_begin); }
                 constexpr size_type get_size() const noexcept {
                     if (write_head == nullptr)
@@ -138,20 +407,11 @@ namespace ftl
                 [[nodiscard]] constexpr allocator_type get_allocator() noexcept { return allocator; }
 
             protected:
-                constexpr static size_t initial_power   = 3;
-                constexpr static size_t initial_size    = 2 << (initial_power - 1);
-                constexpr static size_t grow_factor     = 2;
-
-                inline void grow() {
-                    const size_t new_size = get_capacity() == 0 ? initial_size : get_capacity() * grow_factor;
-                    reserve(new_size);
-                }
-
                 constexpr inline pointer& get_write_head() noexcept { return write_head; }
                 constexpr inline pointer& get_read_head() noexcept { return read_head; }
 
-                constexpr inline const_pointer& get_write_head() const noexcept { return write_head; }
-                constexpr inline const_pointer& get_read_head() const noexcept { return read_head; }
+                constexpr inline const T* get_write_head() const noexcept { return write_head; }
+                constexpr inline const T* get_read_head() const noexcept { return read_head; }
 
             private:
                 pointer read_head = nullptr;
@@ -163,8 +423,8 @@ namespace ftl
                 allocator_type allocator;
         };
 
-        template <typename T, size_t StaticSize>
-        struct ring_buffer_storage<T, ftl::static_storage<StaticSize>, NOT_REFERENCE, TRIVIALLY_DESTRUCTIBLE>
+        template <typename T, size_t StaticSize, size_t Alignment>
+        struct ring_buffer_storage<T, ftl::static_storage<StaticSize, Alignment>, NOT_REFERENCE, TRIVIALLY_DESTRUCTIBLE>
         {
             public:
                 using value_type                        = T;
@@ -175,8 +435,18 @@ namespace ftl
 
                 constexpr static bool is_dynamic        = false;
                 constexpr static size_t data_size       = StaticSize;
+                constexpr static size_t data_alignment  = Alignment > alignof(T) ? Alignment : alignof(T);
+                constexpr static size_t head_alignment  = Alignment > alignof(pointer) ? Alignment : alignof(pointer);
 
                 constexpr ring_buffer_storage() noexcept = default;
+
+                // The heads point into the object itself, so copies start out
+                // empty and elements are copied by ring_buffer_details
+                constexpr ring_buffer_storage(const ring_buffer_storage&) noexcept {}
+                constexpr ring_buffer_storage(ring_buffer_storage&&) noexcept {}
+
+                ring_buffer_storage& operator=(const ring_buffer_storage&) = delete;
+                ring_buffer_storage& operator=(ring_buffer_storage&&) = delete;
                 constexpr ~ring_buffer_storage() noexcept = default;
 
                 constexpr inline bool is_empty() const noexcept { return (write_head == read_head) || read_head == nullptr; }
@@ -194,7 +464,8 @@ namespace ftl
 
                 constexpr inline void release() const noexcept { return; }
 
-                constexpr pointer data() noexcept { return std::launder(reinterpret_cast<pointer>(&store)); }
+                constexpr pointer data() noexcept { return std::launder(reinterpret_cast<pointer>(store)); }
+                constexpr const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(store)); }
                 constexpr size_type get_capacity() const noexcept { return StaticSize; }
                 constexpr size_type get_size() const noexcept {
                     if (write_head == nullptr)
@@ -212,18 +483,18 @@ namespace ftl
                 constexpr inline pointer& get_write_head() noexcept { return write_head; }
                 constexpr inline pointer& get_read_head() noexcept { return read_head; }
 
-                constexpr inline const_pointer& get_write_head() const noexcept { return write_head; }
-                constexpr inline const_pointer& get_read_head() const noexcept { return read_head; }
+                constexpr inline const T* get_write_head() const noexcept { return write_head; }
+                constexpr inline const T* get_read_head() const noexcept { return read_head; }
 
             private:
-                std::aligned_storage_t<sizeof(T), alignof(T)> store[StaticSize];
+                alignas(data_alignment) unsigned char store[sizeof(T) * StaticSize];
 
-                pointer write_head = data();
-                pointer read_head = nullptr;
+                alignas(head_alignment) pointer write_head = data();
+                alignas(head_alignment) pointer read_head = nullptr;
         };
 
-        template <typename T, size_t StaticSize>
-        struct ring_buffer_storage<T, ftl::static_storage<StaticSize>, NOT_REFERENCE, NOT_TRIVIALLY_DESTRUCTIBLE>
+        template <typename T, size_t StaticSize, size_t Alignment>
+        struct ring_buffer_storage<T, ftl::static_storage<StaticSize, Alignment>, NOT_REFERENCE, NOT_TRIVIALLY_DESTRUCTIBLE>
         {
             public:
                 using value_type                        = T;
@@ -234,9 +505,19 @@ namespace ftl
 
                 constexpr static bool is_dynamic        = false;
                 constexpr static size_t data_size       = StaticSize;
+                constexpr static size_t data_alignment  = Alignment > alignof(T) ? Alignment : alignof(T);
+                constexpr static size_t head_alignment  = Alignment > alignof(pointer) ? Alignment : alignof(pointer);
 
                 constexpr ring_buffer_storage() noexcept = default;
 
+                // The heads point into the object itself, so copies start out
+                // empty and elements are copied by ring_buffer_details
+                constexpr ring_buffer_storage(const ring_buffer_storage&) noexcept {}
+                constexpr ring_buffer_storage(ring_buffer_storage&&) noexcept {}
+
+                ring_buffer_storage& operator=(const ring_buffer_storage&) = delete;
+                ring_buffer_storage& operator=(ring_buffer_storage&&) = delete;
+
                 constexpr inline void advance_write_head() noexcept {
                     write_head = write_head == data() + data_size - 1 ? data() : write_head + 1;
                     if (write_head == read_head)
@@ -248,14 +529,7 @@ namespace ftl
                 }
 
                 ~ring_buffer_storage() {
-                    if (read_head == nullptr) {
-                        return;
-                    }
-
-                    if (write_head == nullptr)
-                        write_head = read_head == data() + data_size - 1 ? data() : read_head + 1;
-
-                    while(write_head != read_head) {
+                    for (size_type count = get_size(); count != 0; --count) {
                         get_read_head()->~T();
                         advance_read_head();
                     }
@@ -265,7 +539,8 @@ namespace ftl
                     get_read_head()->~T();
                 }
 
-                constexpr pointer data() noexcept { return std::launder(reinterpret_cast<pointer>(&store)); }
+                constexpr pointer data() noexcept { return std::launder(reinterpret_cast<pointer>(store)); }
+                constexpr const T* data() const noexcept { return std::launder(reinterpret_cast<const T*>(store)); }
                 constexpr size_type get_capacity() const noexcept { return StaticSize; }
                 constexpr size_type get_size() const noexcept {
                     if (write_head == nullptr)
@@ -281,17 +556,17 @@ namespace ftl
                 constexpr inline pointer& get_write_head() noexcept { return write_head; }
                 constexpr inline pointer& get_read_head() noexcept { return read_head; }
 
-                constexpr inline const_pointer& get_write_head() const noexcept { return write_head; }
-                constexpr inline const_pointer& get_read_head() const noexcept { return read_head; }
+                constexpr inline const T* get_write_head() const noexcept { return write_head; }
+                constexpr inline const T* get_read_head() const noexcept { return read_head; }
 
             private:
-                std::aligned_storage_t<sizeof(T), alignof(T)> store[StaticSize];
+                alignas(data_alignment) unsigned char store[sizeof(T) * StaticSize];
 
-                pointer write_head = data();
-                pointer read_head = nullptr;
+                alignas(head_alignment) pointer write_head = data();
+                alignas(head_alignment) pointer read_head = nullptr;
         };
 
-        template <typename T, typename Storage>
+        template <typename T, typename Storage, typename Policy>
         struct ring_buffer_details : ring_buffer_storage<T, Storage>
         {
             using value_type = typename ring_buffer_storage<T, Storage>::value_type;
@@ -306,17 +581,129 @@ namespace ftl
             using ring_buffer_storage<T, Storage>::release;
             using ring_buffer_storage<T, Storage>::data;
 
+            constexpr ring_buffer_details() noexcept = default;
+
+            constexpr ring_buffer_details(const ring_buffer_details& other)
+                noexcept(not is_dynamic && std::is_nothrow_copy_constructible_v<T>)
+                : ring_buffer_storage<T, Storage>(static_cast<const ring_buffer_storage<T, Storage>&>(other)),
+                  shrink_policy(other.shrink_policy),
+                  growth_policy(other.growth_policy),
+                  observer(other.observer)
+            {
+                if constexpr(is_dynamic)
+                    this->reserve(other.get_capacity());
+                copy_elements_from(other);
+            }
+
+            // Allocator-backed storage is taken over as is, static storage has
+            // to move the elements one by one
+            constexpr ring_buffer_details(ring_buffer_details&& other)
+                noexcept(is_dynamic || std::is_nothrow_move_constructible_v<T>)
+                : ring_buffer_storage<T, Storage>(static_cast<ring_buffer_storage<T, Storage>&&>(other)),
+                  shrink_policy(FTL_MOVE(other.shrink_policy)),
+                  growth_policy(FTL_MOVE(other.growth_policy)),
+                  observer(FTL_MOVE(other.observer))
+            {
+                if constexpr(not is_dynamic)
+                    move_elements_from(other, other.get_size());
+            }
+
+            constexpr ring_buffer_details& operator=(const ring_buffer_details& other)
+                noexcept(not is_dynamic && std::is_nothrow_copy_constructible_v<T>)
+            {
+                if (this == &other)
+                    return *this;
+
+                destroy_elements();
+                if constexpr(is_dynamic)
+                    this->reserve(other.get_size());
+                copy_elements_from(other);
+                copy_policies_from(other);
+                return *this;
+            }
+
+            constexpr ring_buffer_details& operator=(ring_buffer_details&& other)
+                noexcept(is_dynamic || std::is_nothrow_move_constructible_v<T>)
+            {
+                if (this == &other)
+                    return *this;
+
+                destroy_elements();
+                if constexpr(is_dynamic)
+                    this->swap_storage(other);
+                else
+                    move_elements_from(other, other.get_size());
+                copy_policies_from(other);
+                return *this;
+            }
+
+            // The policy objects and observer go with the contents
+            constexpr void copy_policies_from(const ring_buffer_details& other) {
+                shrink_policy = other.shrink_policy;
+                growth_policy = other.growth_policy;
+                observer = other.observer;
+            }
+
+            constexpr void swap_policies(ring_buffer_details& other) {
+                shrink_policy_type tmp_shrink = FTL_MOVE(shrink_policy);
+                shrink_policy = FTL_MOVE(other.shrink_policy);
+                other.shrink_policy = FTL_MOVE(tmp_shrink);
+
+                growth_policy_type tmp_growth = FTL_MOVE(growth_policy);
+                growth_policy = FTL_MOVE(other.growth_policy);
+                other.growth_policy = FTL_MOVE(tmp_growth);
+
+                observer_type tmp_observer = FTL_MOVE(observer);
+                observer = FTL_MOVE(other.observer);
+                other.observer = FTL_MOVE(tmp_observer);
+            }
+
+            constexpr void swap_contents(ring_buffer_details& other)
+                noexcept(is_dynamic || std::is_nothrow_move_constructible_v<T>)
+            {
+                if constexpr(is_dynamic) {
+                    this->swap_storage(other);
+                    swap_policies(other);
+                } else {
+                    ring_buffer_details tmp(FTL_MOVE(other));
+                    other = FTL_MOVE(*this);
+                    *this = FTL_MOVE(tmp);
+                }
+            }
+
             constexpr bool is_empty() const noexcept { return (get_write_head() == get_read_head()) || get_read_head() == nullptr; }
             constexpr bool is_full() const noexcept { return get_write_head() == nullptr; }
 
+            // Lets the shrink policy see every push and pop, it is asked before
+            // the operation so no references to the elements are alive
+            constexpr void apply_shrink_policy() {
+                if constexpr(is_dynamic && not std::is_same_v<shrink_policy_type, never_shrink>) {
+                    const size_type capacity = this->get_capacity();
+                    const size_type target = shrink_policy(this->get_size(), capacity);
+                    if (target < capacity)
+                        this->reallocate(target > this->get_size() ? target : this->get_size());
+                }
+            }
+
+            // Grows the storage as the growth policy says, which may give less
+            // than required if it has reached its maximum capacity
+            constexpr void grow(size_type required) requires is_dynamic {
+                const size_type capacity = this->get_capacity();
+                const size_type target = growth_policy(capacity, required, sizeof(T));
+                if (target > capacity)
+                    this->reserve(target);
+            }
+
             template <typename U, bool allow_overwrite = false> requires std::is_convertible_v<U, T>
             constexpr void construct(U&& elem) {
+                apply_shrink_policy();
+
                 if (get_read_head() == nullptr) [[unlikely]]
                     get_read_head() = data();
 
                 if constexpr(is_dynamic) {
                     if ((not allow_overwrite) && is_full())
-                        ring_buffer_storage<T, Storage>::grow();
+                        grow(this->get_capacity() + 1);
                 }
 
                 if (is_full()) {
@@ -331,10 +718,18 @@ namespace ftl
                     release();
                     get_write_head() = get_read_head();
                     advance_read_head();
+
+                    ::new (std::remove_reference_t<T*>(get_write_head())) value_type { FTL_FORWARD(elem) };
+                    advance_write_head();
+
+                    if constexpr(has_observer)
+                        observer.overwritten(1);
+                    return;
                 }
 
                 ::new (std::remove_reference_t<T*>(get_write_head())) value_type { FTL_FORWARD(elem) };
                 advance_write_head();
+                notify_size_change(this->get_size() - 1);
             }
 
             constexpr T&& read_delete() {
@@ -342,6 +737,7 @@ namespace ftl
                     if (is_empty()) throw FTL_EXCEPT_RING_BUFFER_EMPTY;
                 #endif
                 assert(not is_empty());
+                apply_shrink_policy();
 
                 // Does this need launder?
                 T&& val = FTL_MOVE(*(get_read_head()));
@@ -351,6 +747,7 @@ namespace ftl
                 release();
 
                 advance_read_head();
+                notify_size_change(this->get_size() + 1);
                 return FTL_MOVE(val);
             }
 
@@ -359,6 +756,7 @@ namespace ftl
                     if (is_empty()) throw FTL_EXCEPT_RING_BUFFER_EMPTY;
                 #endif
                 assert(not is_empty());
+                apply_shrink_policy();
 
                 T val = *get_read_head();
                 if (get_write_head() == nullptr)
@@ -367,12 +765,19 @@ namespace ftl
                 release();
 
                 advance_read_head();
+                notify_size_change(this->get_size() + 1);
                 return T{val};
             }
 
-            constexpr void clear() noexcept {
-                if constexpr(std::is_trivially_destructible_v<T>) {
-                    while(get_read_head() != get_write_head()) {
+            constexpr void clear() noexcept(nothrow_observer) {
+                const size_type old_size = this->get_size();
+                destroy_elements();
+                notify_size_change(old_size);
+            }
+
+            constexpr void destroy_elements() noexcept {
+                if constexpr(not std::is_trivially_destructible_v<T>) {
+                    for (size_type count = this->get_size(); count != 0; --count) {
                         release();
                         advance_read_head();
                     }
@@ -381,6 +786,185 @@ namespace ftl
                 get_write_head() = data();
             }
 
+            // Stored elements in order as at most two contiguous segments
+            constexpr ring_buffer_segments<T> used_segments() noexcept {
+                if (is_empty())
+                    return {};
+
+                const size_type count = this->get_size();
+                const size_type to_end = static_cast<size_type>(data() + this->get_capacity() - get_read_head());
+                const size_type first_count = count < to_end ? count : to_end;
+
+                return {
+                    { get_read_head(), first_count },
+                    { data(), count - first_count }
+                };
+            }
+
+            // Unused slots following the last element as at most two contiguous segments
+            constexpr ring_buffer_segments<T> free_segments() noexcept {
+                if (is_full())
+                    return {};
+
+                const size_type count = this->get_capacity() - this->get_size();
+                const size_type to_end = static_cast<size_type>(data() + this->get_capacity() - get_write_head());
+                const size_type first_count = count < to_end ? count : to_end;
+
+                return {
+                    { get_write_head(), first_count },
+                    { data(), count - first_count }
+                };
+            }
+
+            // Marks count elements constructed in free_segments() as stored
+            constexpr void commit_write(size_type count) noexcept {
+                if (count == 0)
+                    return;
+
+                if (get_read_head() == nullptr)
+                    get_read_head() = data();
+
+                size_type offset = static_cast<size_type>(get_write_head() - data()) + count;
+                if (offset >= this->get_capacity())
+                    offset -= this->get_capacity();
+
+                get_write_head() = data() + offset;
+                if (get_write_head() == get_read_head())
+                    get_write_head() = nullptr;
+            }
+
+            // Marks count oldest elements, already destroyed by the caller, as free
+            constexpr void commit_read(size_type count) noexcept {
+                if (count == 0)
+                    return;
+
+                if (get_write_head() == nullptr)
+                    get_write_head() = get_read_head();
+
+                size_type offset = static_cast<size_type>(get_read_head() - data()) + count;
+                if (offset >= this->get_capacity())
+                    offset -= this->get_capacity();
+
+                get_read_head() = data() + offset;
+            }
+
+            template <typename OtherStorage, typename OtherPolicy>
+            constexpr size_type transfer_from(ring_buffer_details<T, OtherStorage, OtherPolicy>& src, size_type count) {
+                const size_type old_size = this->get_size();
+                const size_type src_old_size = src.get_size();
+
+                count = move_elements_from(src, count);
+                if (count != 0) {
+                    notify_size_change(old_size);
+                    src.notify_size_change(src_old_size);
+                }
+                return count;
+            }
+
+            // transfer_from() without telling the observers
+            template <typename OtherStorage, typename OtherPolicy>
+            constexpr size_type move_elements_from(ring_buffer_details<T, OtherStorage, OtherPolicy>& src, size_type count) {
+                if (static_cast<void*>(&src) == static_cast<void*>(this))
+                    return 0;
+
+                if (count > src.get_size())
+                    count = src.get_size();
+
+                // the policy has to match too, or the capacity could exceed our maximum
+                if constexpr(is_dynamic && std::is_same_v<Storage, OtherStorage> && std::is_same_v<Policy, OtherPolicy>) {
+                    if (is_empty() && count == src.get_size() && this->has_equal_allocator(src)) {
+                        destroy_elements();
+                        this->swap_storage(src);
+                        src.destroy_elements();
+                        return count;
+                    }
+                }
+
+                if constexpr(is_dynamic) {
+                    const size_type required = this->get_size() + count;
+                    if (required > this->get_capacity())
+                        grow(required);
+                }
+
+                // static storage, or a growth policy at its maximum, takes what fits
+                const size_type available = this->get_capacity() - this->get_size();
+                if (count > available)
+                    count = available;
+
+                ring_buffer_segments<T> from = src.used_segments();
+                ring_buffer_segments<T> to = free_segments();
+
+                // At most four pieces, each contiguous on both sides
+                size_type done = 0;
+                while (done < count) {
+                    T* src_ptr = done < from.first.size() ? from.first.data() + done : from.second.data() + (done - from.first.size());
+                    T* dst_ptr = done < to.first.size() ? to.first.data() + done : to.second.data() + (done - to.first.size());
+
+                    size_type piece = count - done;
+                    if (done < from.first.size() && from.first.size() - done < piece)
+                        piece = from.first.size() - done;
+                    if (done < to.first.size() && to.first.size() - done < piece)
+                        piece = to.first.size() - done;
+
+                    relocate_elements(dst_ptr, src_ptr, piece);
+                    done += piece;
+                }
+
+                commit_write(count);
+                src.commit_read(count);
+                return count;
+            }
+
+            // Copies the elements of other to this buffer, which must be empty and
+            // have the room for them.  Trivially copyable elements are copied with
+            // at most two memcpy calls.
+            constexpr void copy_elements_from(const ring_buffer_details& other) {
+                ring_buffer_segments<T> from = const_cast<ring_buffer_details&>(other).used_segments();
+                if (from.empty())
+                    return;
+
+                assert(is_empty() && get_write_head() == data());
+
+                copy_elements(data(), from.first.data(), from.first.size());
+                copy_elements(data() + from.first.size(), from.second.data(), from.second.size());
+                commit_write(from.size());
+            }
+
+            // Copies count elements to uninitialised memory
+            constexpr static void copy_elements(T* dst, const T* src, size_type count) {
+                if constexpr(std::is_trivially_copyable_v<T>) {
+                    if (not std::is_constant_evaluated()) {
+                        if (count != 0)
+                            memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+                        return;
+                    }
+                }
+
+                for (size_type i = 0; i < count; ++i)
+                    ::new (static_cast<void*>(dst + i)) T(src[i]);
+            }
+
+            // Moves count elements to uninitialised memory and destroys the originals
+            constexpr static void relocate_elements(T* dst, T* src, size_type count) {
+                if constexpr(std::is_trivially_copyable_v<T>) {
+                    if (not std::is_constant_evaluated()) {
+                        if (count != 0)
+                            memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+                        return;
+                    }
+                }
+
+                for (size_type i = 0; i < count; ++i) {
+                    if constexpr(std::is_move_constructible_v<T>)
+                        ::new (static_cast<void*>(dst + i)) T(FTL_MOVE(src[i]));
+                    else
+                        ::new (static_cast<void*>(dst + i)) T(src[i]);
+
+                    if constexpr(not std::is_trivially_destructible_v<T>)
+                        src[i].~T();
+                }
+            }
+
             constexpr bool is_contiguous() const noexcept {
                 if (get_read_head() == nullptr)
                     return true;
@@ -409,12 +993,31 @@ namespace ftl
 
                 return *(data() + rel_index);
             }
+
+            constexpr void notify_size_change(size_type old_size) {
+                if constexpr(has_observer)
+                    observer.size_changed(old_size, this->get_size(), this->get_capacity());
+            }
+
+            using shrink_policy_type = typename Policy::shrink_policy;
+            using growth_policy_type = typename Policy::growth_policy;
+            using observer_type = typename Policy::observer;
+            constexpr static bool has_observer = not std::is_same_v<observer_type, no_observer>;
+            constexpr static bool nothrow_observer = noexcept(std::declval<observer_type&>().size_changed(0, 0, 0))
+                                                  && noexcept(std::declval<observer_type&>().overwritten(0));
+
+            [[no_unique_address]] shrink_policy_type shrink_policy;
+            [[no_unique_address]] growth_policy_type growth_policy;
+            [[no_unique_address]] observer_type observer;
         };
     }
 
-    template <typename T, typename Storage = FTL_DEFAULT_ALLOCATOR>
-    class ring_buffer : detail::ring_buffer_details<T, Storage>
+    template <typename T, typename Storage = FTL_DEFAULT_ALLOCATOR, typename Policy = default_ring_buffer_policy>
+    class ring_buffer : detail::ring_buffer_details<T, Storage, Policy>
     {
+        template <typename, typename, typename>
+        friend class ring_buffer;
+
         public:
             using value_type        = T;
             using size_type         = std::size_t;
@@ -433,6 +1036,7 @@ namespace ftl
             using const_iterator = rb_iterator<true>;
 
             using detail::ring_buffer_storage<T, Storage>::is_dynamic;
+            using detail::ring_buffer_details<T, Storage, Policy>::nothrow_observer;
 
             constexpr ring_buffer() = default;
 
@@ -445,16 +1049,16 @@ namespace ftl
 
             // modifiers
             template <typename U> requires std::is_convertible_v<U, T>
-            constexpr void push(U&& elem) noexcept(std::is_nothrow_move_constructible<T>::value) { this->construct(FTL_FORWARD(elem)); }
+            constexpr void push(U&& elem) { this->construct(FTL_FORWARD(elem)); }
 
             template <typename U>
-            constexpr void push(const U& elem) noexcept(std::is_nothrow_copy_constructible<T>::value) { this->construct(elem); }
+            constexpr void push(const U& elem) { this->construct(elem); }
 
             template <typename U> requires std::is_convertible_v<U, T>
-            constexpr void push_overwrite(U&& elem) noexcept(std::is_nothrow_move_constructible<T>::value) { this->template construct<U, true>(FTL_FORWARD(elem)); }
+            constexpr void push_overwrite(U&& elem) noexcept(std::is_nothrow_move_constructible<T>::value && nothrow_observer) { this->template construct<U, true>(FTL_FORWARD(elem)); }
 
             template <typename U> requires std::is_convertible_v<U, T>
-            constexpr void push_overwrite(const T& elem) noexcept(std::is_nothrow_copy_constructible<T>::value) { this->template construct<U, true>(FTL_FORWARD(elem)); }
+            constexpr void push_overwrite(const T& elem) noexcept(std::is_nothrow_copy_constructible<T>::value && nothrow_observer) { this->template construct<U, true>(FTL_FORWARD(elem)); }
 
             [[nodiscard]] constexpr T&& pop() requires std::is_move_assignable_v<T> { return this->read_delete(); }
             // FIXME: This causes an extra copy.
@@ -462,8 +1066,29 @@ namespace ftl
 
             constexpr void reserve(size_type count) requires is_dynamic { detail::ring_buffer_storage<T, Storage>::reserve(count); }
             constexpr void reserve(size_type count) const noexcept requires (!is_dynamic) {}
-            constexpr void clear() noexcept { detail::ring_buffer_details<T, Storage>::clear(); }
-            constexpr void swap(ring_buffer& rhs) { swap(*this, rhs); }
+            // Reallocates to exactly size() elements, an empty buffer releases its memory
+            constexpr void shrink_to_fit() requires is_dynamic { this->reallocate(this->get_size()); }
+            constexpr void shrink_to_fit() const noexcept requires (!is_dynamic) {}
+            constexpr void clear() noexcept(nothrow_observer) { detail::ring_buffer_details<T, Storage, Policy>::clear(); }
+
+            // The observer of the policy, e.g. to set watermarks
+            [[nodiscard]] constexpr typename Policy::observer& get_observer() noexcept { return this->observer; }
+            [[nodiscard]] constexpr const typename Policy::observer& get_observer() const noexcept { return this->observer; }
+            constexpr void swap(ring_buffer& rhs) noexcept(is_dynamic || std::is_nothrow_move_constructible_v<T>) {
+                detail::ring_buffer_details<T, Storage, Policy>::swap_contents(rhs);
+            }
+
+            // Moves up to count oldest elements of src to the end of this buffer and
+            // returns how many were moved, static storage or a growth policy at its
+            // maximum takes only what fits.
+            // Trivially copyable elements are copied in at most four memcpy calls.
+            // If this buffer is empty and all of src is moved between buffers of the
+            // same allocator-backed type, the allocations are swapped instead.
+            template <typename OtherStorage, typename OtherPolicy>
+            constexpr size_type transfer_from(ring_buffer<T, OtherStorage, OtherPolicy>& src, size_type count) {
+                detail::ring_buffer_details<T, OtherStorage, OtherPolicy>& src_details = src;
+                return detail::ring_buffer_details<T, Storage, Policy>::transfer_from(src_details, count);
+            }
 
             // element access
             [[nodiscard]] constexpr reference front() noexcept { return *begin(); }
@@ -471,29 +1096,40 @@ namespace ftl
             [[nodiscard]] constexpr reference back() noexcept { return *(--end()); }
             [[nodiscard]] constexpr const_reference back() const noexcept { return *(--end()); }
 
-            [[nodiscard]] constexpr reference operator[](difference_type index) noexcept { return detail::ring_buffer_details<T, Storage>::nth_element(index); }
-            [[nodiscard]] constexpr const_reference operator[](difference_type index) const noexcept { return detail::ring_buffer_details<T, Storage>::nth_element(index); }
+            [[nodiscard]] constexpr ring_buffer_segments<T> segments() noexcept { return this->used_segments(); }
+            [[nodiscard]] constexpr ring_buffer_segments<const T> segments() const noexcept {
+                auto seg = const_cast<ring_buffer*>(this)->used_segments();
+                return { { seg.first.data(), seg.first.size() }, { seg.second.data(), seg.second.size() } };
+            }
+
+            [[nodiscard]] constexpr reference operator[](difference_type index) noexcept { return detail::ring_buffer_details<T, Storage, Policy>::nth_element(index); }
+            [[nodiscard]] constexpr const_reference operator[](difference_type index) const noexcept { return detail::ring_buffer_details<T, Storage, Policy>::nth_element(index); }
 
             // queries
             [[nodiscard]] constexpr size_type size() const noexcept { return detail::ring_buffer_storage<T, Storage>::get_size(); }
             [[nodiscard]] constexpr size_type capacity() const noexcept { return detail::ring_buffer_storage<T, Storage>::get_capacity(); }
-            [[nodiscard]] constexpr bool is_empty() const noexcept { return detail::ring_buffer_storage<T, Storage>::is_empty(); }
-            [[nodiscard]] constexpr bool is_full() const noexcept { return detail::ring_buffer_storage<T, Storage>::is_full(); }
+            [[nodiscard]] constexpr bool is_empty() const noexcept { return detail::ring_buffer_details<T, Storage, Policy>::is_empty(); }
+            [[nodiscard]] constexpr bool is_full() const noexcept { return detail::ring_buffer_details<T, Storage, Policy>::is_full(); }
 
-            [[nodiscard]] constexpr bool is_contiguous() const noexcept { return detail::ring_buffer_storage<T, Storage>::is_contiguous(); }
+            [[nodiscard]] constexpr bool is_contiguous() const noexcept { return detail::ring_buffer_details<T, Storage, Policy>::is_contiguous(); }
 
     };
 
+    template <typename T, typename Storage, typename Policy>
+    constexpr void swap(ring_buffer<T, Storage, Policy>& lhs, ring_buffer<T, Storage, Policy>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+        lhs.swap(rhs);
+    }
+
     // Cannot use iterator concepts before Defect report P2325R3 is fixed in compilers,
     // we are not default-constructible
-    template <typename T, typename Storage> template <bool Is_Const>
-    class ring_buffer<T, Storage>::rb_iterator
+    template <typename T, typename Storage, typename Policy> template <bool Is_Const>
+    class ring_buffer<T, Storage, Policy>::rb_iterator
     {
-        using target_reference = typename std::conditional<Is_Const, const ring_buffer<T, Storage>&, ring_buffer<T, Storage>&>::type;
-        using target_pointer = typename std::conditional<Is_Const, const ring_buffer<T, Storage>*, ring_buffer<T, Storage>*>::type;
+        using target_reference = typename std::conditional<Is_Const, const ring_buffer<T, Storage, Policy>&, ring_buffer<T, Storage, Policy>&>::type;
+        using target_pointer = typename std::conditional<Is_Const, const ring_buffer<T, Storage, Policy>*, ring_buffer<T, Storage, Policy>*>::type;
 
         public:
-            using value_type        = ring_buffer<T, Storage>::value_type;
+            using value_type        = ring_buffer<T, Storage, Policy>::value_type;
             using pointer           = typename std::conditional<Is_Const, const T*, T*>::type;
             using difference_type   = std::ptrdiff_t;
 
@@ -0,0 +1,141 @@
+#ifndef FTL_SEQLOCK_RING_BUFFER_HPP
+#define FTL_SEQLOCK_RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <string.h>
+
+#include "memory.hpp"
+
+namespace ftl
+{
+    // Fixed-size ring buffer for one writer thread and any number of reader
+    // threads.  The writer always overwrites the oldest element when full and
+    // never waits for readers; readers copy out a window of the newest
+    // elements and retry if the writer wrapped around over it meanwhile.
+    //
+    // Elements are copied through relaxed atomic words so that concurrent
+    // reads and writes are not data races, which limits this to trivially
+    // copyable types.  Reading a window close to Capacity while the writer is
+    // busy retries often, leave some slack.
+    template <typename T, std::size_t Capacity>
+    class seqlock_ring_buffer
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "seqlock_ring_buffer copies elements bytewise");
+        static_assert(Capacity > 0);
+
+        using word = std::uint64_t;
+        constexpr static std::size_t words_per_slot = (sizeof(T) + sizeof(word) - 1) / sizeof(word);
+
+        public:
+            using value_type    = T;
+            using size_type     = std::size_t;
+
+            seqlock_ring_buffer() noexcept = default;
+
+            seqlock_ring_buffer(const seqlock_ring_buffer&) = delete;
+            seqlock_ring_buffer& operator=(const seqlock_ring_buffer&) = delete;
+
+            // writer only
+            void push(const T& value) noexcept {
+                const std::uint64_t index = finished.load(std::memory_order_relaxed);
+
+                word buffer[words_per_slot] = {};
+                memcpy(static_cast<void*>(buffer), static_cast<const void*>(&value), sizeof(T));
+
+                // announce the write before touching the slot, readers that see
+                // any of the new words also see this
+                started.store(index + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                word* slot = slot_words(index);
+                for (std::size_t i = 0; i < words_per_slot; ++i)
+                    std::atomic_ref<word>(slot[i]).store(buffer[i], std::memory_order_relaxed);
+
+                finished.store(index + 1, std::memory_order_release);
+            }
+
+            // readers, any thread
+
+            // Copies the newest min(count, size()) elements, oldest first, to out
+            // and returns how many were copied
+            size_type read_latest(T* out, size_type count) const noexcept {
+                if (count > Capacity)
+                    count = Capacity;
+
+                for (;;) {
+                    const std::uint64_t end = finished.load(std::memory_order_acquire);
+                    const size_type available = end < Capacity ? static_cast<size_type>(end) : Capacity;
+                    const size_type n = count < available ? count : available;
+                    const std::uint64_t begin = end - n;
+
+                    for (std::uint64_t index = begin; index != end; ++index)
+                        copy_out(index, out + (index - begin));
+
+                    // a write that any of the copies saw has made started reach
+                    // past it, so the window is intact if none of its slots has
+                    // been handed to a later index
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    const std::uint64_t overwritten = started.load(std::memory_order_relaxed);
+                    if (overwritten <= begin + Capacity)
+                        return n;
+                }
+            }
+
+            // Copies the newest element to out, false if there is none
+            bool read_latest(T& out) const noexcept { return read_latest(&out, 1) == 1; }
+
+            [[nodiscard]] size_type size() const noexcept {
+                const std::uint64_t end = finished.load(std::memory_order_acquire);
+                return end < Capacity ? static_cast<size_type>(end) : Capacity;
+            }
+
+            [[nodiscard]] constexpr size_type capacity() const noexcept { return Capacity; }
+
+            // Number of elements ever pushed, readers can use it to tell whether
+            // anything new has arrived
+            [[nodiscard]] std::uint64_t pushed() const noexcept { return finished.load(std::memory_order_acquire); }
+
+        private:
+            word* slot_words(std::uint64_t index) const noexcept {
+                return slots + (index % Capacity) * words_per_slot;
+            }
+
+            void copy_out(std::uint64_t index, T* out) const noexcept {
+                word buffer[words_per_slot];
+                word* slot = slot_words(index);
+                for (std::size_t i = 0; i < words_per_slot; ++i)
+                    buffer[i] = std::atomic_ref<word>(slot[i]).load(std::memory_order_relaxed);
+                memcpy(static_cast<void*>(out), static_cast<const void*>(buffer), sizeof(T));
+            }
+
+            // writes started and finished, readers and the writer touch both so
+            // they are kept off the line of the data
+            alignas(cache_line_size) std::atomic<std::uint64_t> started { 0 };
+            std::atomic<std::uint64_t> finished { 0 };
+
+            alignas(cache_line_size) mutable word slots[Capacity * words_per_slot] = {};
+    };
+}
+
+#endif
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
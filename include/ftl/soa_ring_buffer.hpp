@@ -0,0 +1,412 @@
+#ifndef FTL_SOA_RINGBUFFER_HPP
+#define FTL_SOA_RINGBUFFER_HPP
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <new>
+
+#include "memory.hpp"
+#include "utility.hpp"
+#include "ring_buffer.hpp"
+
+#if __STDC_HOSTED__ == 1
+# define FTL_DEFAULT_SOA_STORAGE std::allocator<unsigned char>
+#else
+# define FTL_DEFAULT_SOA_STORAGE ftl::static_storage<32>
+#endif
+
+namespace ftl
+{
+    namespace detail {
+        template <typename Storage, typename... Fields>
+        struct soa_ring_buffer_columns
+        {
+            static_assert(always_false<Storage>, "Could not use provided storage type as allocator or static storage");
+        };
+
+        // Columns are rebound from the given allocator, so its value_type does not matter
+        template <any_with_required_allocator_traits Allocator, typename... Fields>
+        struct soa_ring_buffer_columns<Allocator, Fields...>
+        {
+            using size_type                     = std::size_t;
+            using allocator_type                = Allocator;
+
+            constexpr static bool is_dynamic    = true;
+
+            template <typename F>
+            using column_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<F>;
+
+            constexpr soa_ring_buffer_columns() noexcept = default;
+
+            template <std::size_t I>
+            constexpr auto column() const noexcept { return std::get<I>(columns); }
+
+            constexpr size_type get_capacity() const noexcept { return capacity; }
+
+            // Allocates new columns without moving anything over
+            constexpr soa_ring_buffer_columns allocate_like(size_type new_capacity) {
+                soa_ring_buffer_columns result;
+                result.allocator = allocator;
+                result.allocate_columns(new_capacity, std::index_sequence_for<Fields...>{});
+                return result;
+            }
+
+            constexpr void swap(soa_ring_buffer_columns& other) noexcept {
+                std::swap(columns, other.columns);
+                std::swap(capacity, other.capacity);
+                std::swap(allocator, other.allocator);
+            }
+
+            constexpr void deallocate() noexcept {
+                if (capacity == 0)
+                    return;
+                deallocate_columns(std::index_sequence_for<Fields...>{});
+                capacity = 0;
+            }
+
+            [[nodiscard]] constexpr allocator_type get_allocator() const noexcept { return allocator; }
+
+            private:
+                template <std::size_t... I>
+                constexpr void allocate_columns(size_type new_capacity, std::index_sequence<I...>) {
+                    ((std::get<I>(columns) = column_allocator<Fields>(allocator).allocate(new_capacity)), ...);
+                    capacity = new_capacity;
+                }
+
+                template <std::size_t... I>
+                constexpr void deallocate_columns(std::index_sequence<I...>) noexcept {
+                    (column_allocator<Fields>(allocator).deallocate(std::get<I>(columns), capacity), ...);
+                    columns = {};
+                }
+
+                std::tuple<Fields*...> columns {};
+                size_type capacity = 0;
+                [[no_unique_address]] allocator_type allocator;
+        };
+
+        template <typename F>
+        constexpr void destroy_field(F& field) noexcept { field.~F(); }
+
+        template <typename F, std::size_t Size, std::size_t Alignment>
+        struct soa_static_column
+        {
+            F* data() noexcept { return std::launder(reinterpret_cast<F*>(store)); }
+            const F* data() const noexcept { return std::launder(reinterpret_cast<const F*>(store)); }
+
+            alignas(Alignment > alignof(F) ? Alignment : alignof(F)) unsigned char store[sizeof(F) * Size];
+        };
+
+        template <std::size_t StaticSize, std::size_t Alignment, typename... Fields>
+        struct soa_ring_buffer_columns<ftl::static_storage<StaticSize, Alignment>, Fields...>
+        {
+            using size_type                     = std::size_t;
+            using allocator_type                = void;
+
+            constexpr static bool is_dynamic    = false;
+
+            template <std::size_t I>
+            constexpr auto column() const noexcept {
+                // columns are logically part of the buffer value, constness is
+                // handled by basic_soa_ring_buffer
+                auto& col = const_cast<soa_ring_buffer_columns*>(this)->columns;
+                return std::get<I>(col).data();
+            }
+
+            constexpr size_type get_capacity() const noexcept { return StaticSize; }
+
+            private:
+                std::tuple<soa_static_column<Fields, StaticSize, Alignment>...> columns;
+        };
+    }
+
+    // Ring buffer storing each field of its element in a separate column, so
+    // that scanning a single field touches only that field's memory.  Behaves
+    // like ftl::ring_buffer otherwise: push() grows allocator-backed storage
+    // and fails on full static storage, push_overwrite() drops the oldest
+    // element when full.
+    template <typename Storage, typename... Fields>
+    class basic_soa_ring_buffer : detail::soa_ring_buffer_columns<Storage, Fields...>
+    {
+        using columns_type = detail::soa_ring_buffer_columns<Storage, Fields...>;
+
+        static_assert(sizeof...(Fields) > 0, "soa_ring_buffer needs at least one field");
+        static_assert((not std::is_reference_v<Fields> && ...), "Reference storage not implemented");
+
+        public:
+            using value_type        = std::tuple<Fields...>;
+            using size_type         = std::size_t;
+            using difference_type   = std::ptrdiff_t;
+            using allocator_type    = typename columns_type::allocator_type;
+
+            template <std::size_t I>
+            using field_type        = std::tuple_element_t<I, value_type>;
+
+            constexpr static std::size_t field_count = sizeof...(Fields);
+
+            using columns_type::is_dynamic;
+
+            constexpr basic_soa_ring_buffer() noexcept = default;
+
+            constexpr basic_soa_ring_buffer(const basic_soa_ring_buffer& other) {
+                append_from(other, std::index_sequence_for<Fields...>{});
+            }
+
+            constexpr basic_soa_ring_buffer(basic_soa_ring_buffer&& other) noexcept((std::is_nothrow_move_constructible_v<Fields> && ...)) {
+                if constexpr(is_dynamic) {
+                    columns_type::swap(other);
+                    std::swap(read_index, other.read_index);
+                    std::swap(count, other.count);
+                } else {
+                    append_from(FTL_MOVE(other), std::index_sequence_for<Fields...>{});
+                    other.clear();
+                }
+            }
+
+            constexpr basic_soa_ring_buffer& operator=(const basic_soa_ring_buffer& other) {
+                if (this != &other) {
+                    clear();
+                    append_from(other, std::index_sequence_for<Fields...>{});
+                }
+                return *this;
+            }
+
+            constexpr basic_soa_ring_buffer& operator=(basic_soa_ring_buffer&& other) noexcept((std::is_nothrow_move_constructible_v<Fields> && ...)) {
+                if (this == &other)
+                    return *this;
+
+                clear();
+                if constexpr(is_dynamic) {
+                    columns_type::swap(other);
+                    std::swap(read_index, other.read_index);
+                    std::swap(count, other.count);
+                } else {
+                    append_from(FTL_MOVE(other), std::index_sequence_for<Fields...>{});
+                    other.clear();
+                }
+                return *this;
+            }
+
+            constexpr ~basic_soa_ring_buffer() {
+                clear();
+                if constexpr(is_dynamic)
+                    columns_type::deallocate();
+            }
+
+            // modifiers
+            template <typename... Us> requires (sizeof...(Us) == sizeof...(Fields))
+            constexpr void push(Us&&... values) {
+                if (is_full()) {
+                    if constexpr(is_dynamic) {
+                        grow();
+                    } else {
+                        #ifdef __cpp_exceptions
+                            throw FTL_EXCEPT_RING_BUFFER_FULL;
+                        #endif
+                        assert(not is_full());
+                        // just overwrite if NDEBUG and no exceptions
+                        drop_front();
+                    }
+                }
+                construct_back(std::index_sequence_for<Fields...>{}, FTL_FORWARD(values)...);
+            }
+
+            template <typename... Us> requires (sizeof...(Us) == sizeof...(Fields))
+            constexpr void push_overwrite(Us&&... values) {
+                if constexpr(is_dynamic)
+                    if (capacity() == 0)
+                        grow();
+
+                if (is_full())
+                    drop_front();
+
+                construct_back(std::index_sequence_for<Fields...>{}, FTL_FORWARD(values)...);
+            }
+
+            [[nodiscard]] constexpr value_type pop() {
+                #ifdef __cpp_exceptions
+                    if (is_empty()) throw FTL_EXCEPT_RING_BUFFER_EMPTY;
+                #endif
+                assert(not is_empty());
+
+                value_type result = take_front(std::index_sequence_for<Fields...>{});
+                drop_front();
+                return result;
+            }
+
+            // Removes up to count oldest elements without reading them
+            constexpr void discard(size_type n) noexcept {
+                while (n-- != 0 && not is_empty())
+                    drop_front();
+            }
+
+            constexpr void reserve(size_type new_capacity) requires is_dynamic {
+                if (new_capacity <= capacity())
+                    return;
+                relocate(new_capacity);
+            }
+            constexpr void reserve(size_type) const noexcept requires (!is_dynamic) {}
+
+            constexpr void clear() noexcept {
+                if constexpr(not (std::is_trivially_destructible_v<Fields> && ...)) {
+                    while (not is_empty())
+                        drop_front();
+                }
+                read_index = 0;
+                count = 0;
+            }
+
+            // element access, index is relative to the oldest element
+            template <std::size_t I>
+            [[nodiscard]] constexpr field_type<I>& get(size_type index) noexcept {
+                return column_data<I>()[physical_index(index)];
+            }
+
+            template <std::size_t I>
+            [[nodiscard]] constexpr const field_type<I>& get(size_type index) const noexcept {
+                return column_data<I>()[physical_index(index)];
+            }
+
+            template <std::size_t I>
+            [[nodiscard]] constexpr field_type<I>& front() noexcept { return get<I>(0); }
+            template <std::size_t I>
+            [[nodiscard]] constexpr const field_type<I>& front() const noexcept { return get<I>(0); }
+            template <std::size_t I>
+            [[nodiscard]] constexpr field_type<I>& back() noexcept { return get<I>(count - 1); }
+            template <std::size_t I>
+            [[nodiscard]] constexpr const field_type<I>& back() const noexcept { return get<I>(count - 1); }
+
+            // Contents of a single column in order, as at most two contiguous segments
+            template <std::size_t I>
+            [[nodiscard]] constexpr ring_buffer_segments<field_type<I>> column() noexcept {
+                return make_segments(column_data<I>());
+            }
+
+            template <std::size_t I>
+            [[nodiscard]] constexpr ring_buffer_segments<const field_type<I>> column() const noexcept {
+                return make_segments(static_cast<const field_type<I>*>(column_data<I>()));
+            }
+
+            // queries
+            [[nodiscard]] constexpr size_type size() const noexcept { return count; }
+            [[nodiscard]] constexpr size_type capacity() const noexcept { return columns_type::get_capacity(); }
+            [[nodiscard]] constexpr bool is_empty() const noexcept { return count == 0; }
+            [[nodiscard]] constexpr bool is_full() const noexcept { return count == capacity(); }
+            [[nodiscard]] constexpr bool is_contiguous() const noexcept { return read_index + count <= capacity(); }
+
+        private:
+            constexpr static size_type initial_size = 8;
+            constexpr static size_type grow_factor  = 2;
+
+            template <std::size_t I>
+            constexpr field_type<I>* column_data() const noexcept { return columns_type::template column<I>(); }
+
+            constexpr size_type physical_index(size_type index) const noexcept {
+                index += read_index;
+                return index >= capacity() ? index - capacity() : index;
+            }
+
+            template <typename F>
+            constexpr ring_buffer_segments<F> make_segments(F* base) const noexcept {
+                const size_type first_count = read_index + count <= capacity() ? count : capacity() - read_index;
+                return {
+                    { base + read_index, first_count },
+                    { base, count - first_count }
+                };
+            }
+
+            template <std::size_t... I, typename... Us>
+            constexpr void construct_back(std::index_sequence<I...>, Us&&... values) {
+                const size_type slot = physical_index(count);
+                (::new (static_cast<void*>(column_data<I>() + slot)) field_type<I>(FTL_FORWARD(values)), ...);
+                ++count;
+            }
+
+            template <std::size_t... I>
+            constexpr value_type take_front(std::index_sequence<I...>) {
+                return value_type { FTL_MOVE(column_data<I>()[read_index])... };
+            }
+
+            template <std::size_t... I>
+            constexpr void destroy_front(std::index_sequence<I...>) noexcept {
+                (detail::destroy_field(column_data<I>()[read_index]), ...);
+            }
+
+            constexpr void drop_front() noexcept {
+                if constexpr(not (std::is_trivially_destructible_v<Fields> && ...))
+                    destroy_front(std::index_sequence_for<Fields...>{});
+
+                read_index = read_index + 1 == capacity() ? 0 : read_index + 1;
+                --count;
+            }
+
+            template <typename Other, std::size_t... I>
+            constexpr void append_from(Other&& other, std::index_sequence<I...> seq) {
+                if constexpr(is_dynamic)
+                    reserve(other.size());
+
+                for (size_type i = 0; i < other.size(); ++i) {
+                    if constexpr(std::is_rvalue_reference_v<Other&&>)
+                        construct_back(seq, FTL_MOVE(other.template get<I>(i))...);
+                    else
+                        construct_back(seq, other.template get<I>(i)...);
+                }
+            }
+
+            constexpr void grow() requires is_dynamic {
+                relocate(capacity() == 0 ? initial_size : capacity() * grow_factor);
+            }
+
+            // Moves the contents to new columns so that the oldest element is at index 0
+            constexpr void relocate(size_type new_capacity) requires is_dynamic {
+                columns_type new_columns = columns_type::allocate_like(new_capacity);
+                relocate_columns(new_columns, std::index_sequence_for<Fields...>{});
+
+                const size_type old_count = count;
+                clear();
+                columns_type::swap(new_columns);
+                new_columns.deallocate();
+
+                read_index = 0;
+                count = old_count;
+            }
+
+            template <std::size_t... I>
+            constexpr void relocate_columns(columns_type& target, std::index_sequence<I...>) {
+                (relocate_column<I>(target.template column<I>()), ...);
+            }
+
+            template <std::size_t I>
+            constexpr void relocate_column(field_type<I>* target) {
+                for (size_type i = 0; i < count; ++i)
+                    ::new (static_cast<void*>(target + i)) field_type<I>(FTL_MOVE(get<I>(i)));
+            }
+
+            size_type read_index = 0;
+            size_type count = 0;
+    };
+
+    template <typename... Fields>
+    using soa_ring_buffer = basic_soa_ring_buffer<FTL_DEFAULT_SOA_STORAGE, Fields...>;
+}
+
+#endif
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
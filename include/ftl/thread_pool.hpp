@@ -0,0 +1,461 @@
+#ifndef FTL_THREAD_POOL_HPP
+#define FTL_THREAD_POOL_HPP
+
+// Threads are not available in freestanding environments, so this header
+// is empty there.
+#if __STDC_HOSTED__ == 1
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "utility.hpp"
+
+namespace ftl
+{
+    namespace detail {
+        struct pool_task
+        {
+            virtual ~pool_task() = default;
+            virtual void run() = 0;
+        };
+
+        template <typename F>
+        struct pool_task_impl final : pool_task
+        {
+            template <typename U>
+            explicit pool_task_impl(U&& fn) : fn(FTL_FORWARD(fn)) {}
+
+            void run() override { fn(); }
+
+            F fn;
+        };
+
+        // Chase-Lev work-stealing deque, as described in "Correct and Efficient
+        // Work-Stealing for Weak Memory Models" (Lê et al. 2013).  The owning
+        // worker pushes and takes at the bottom, other workers steal from the top.
+        class work_stealing_deque
+        {
+            struct ring
+            {
+                explicit ring(std::int64_t capacity)
+                    : capacity(capacity), slots(new std::atomic<pool_task*>[capacity]) {}
+
+                pool_task* get(std::int64_t index) const noexcept {
+                    return slots[index & (capacity - 1)].load(std::memory_order_relaxed);
+                }
+
+                void put(std::int64_t index, pool_task* task) noexcept {
+                    slots[index & (capacity - 1)].store(task, std::memory_order_relaxed);
+                }
+
+                std::int64_t capacity;
+                std::unique_ptr<std::atomic<pool_task*>[]> slots;
+            };
+
+            public:
+                explicit work_stealing_deque(std::int64_t initial_capacity = 256) {
+                    retired.push_back(std::make_unique<ring>(initial_capacity));
+                    buffer.store(retired.back().get(), std::memory_order_relaxed);
+                }
+
+                work_stealing_deque(const work_stealing_deque&) = delete;
+                work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+                // owner only
+                void push(pool_task* task) {
+                    std::int64_t b = bottom.load(std::memory_order_relaxed);
+                    std::int64_t t = top.load(std::memory_order_acquire);
+                    ring* r = buffer.load(std::memory_order_relaxed);
+
+                    if (b - t > r->capacity - 1)
+                        r = grow(r, b, t);
+
+                    r->put(b, task);
+                    bottom.store(b + 1, std::memory_order_release);
+                }
+
+                // owner only
+                pool_task* take() noexcept {
+                    std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+                    ring* r = buffer.load(std::memory_order_relaxed);
+                    bottom.store(b, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    std::int64_t t = top.load(std::memory_order_relaxed);
+
+                    if (t > b) {
+                        bottom.store(b + 1, std::memory_order_relaxed);
+                        return nullptr;
+                    }
+
+                    pool_task* task = r->get(b);
+                    if (t == b) {
+                        // last element, race against thieves
+                        if (not top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                            task = nullptr;
+                        bottom.store(b + 1, std::memory_order_relaxed);
+                    }
+                    return task;
+                }
+
+                // any thread
+                pool_task* steal() noexcept {
+                    std::int64_t t = top.load(std::memory_order_acquire);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    std::int64_t b = bottom.load(std::memory_order_acquire);
+
+                    if (t >= b)
+                        return nullptr;
+
+                    pool_task* task = buffer.load(std::memory_order_acquire)->get(t);
+                    if (not top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                        return nullptr;
+
+                    return task;
+                }
+
+            private:
+                // Old rings are kept alive until the deque dies, since a thief
+                // may still be reading from one.
+                ring* grow(ring* old, std::int64_t b, std::int64_t t) {
+                    retired.push_back(std::make_unique<ring>(old->capacity * 2));
+                    ring* r = retired.back().get();
+                    for (std::int64_t i = t; i < b; ++i)
+                        r->put(i, old->get(i));
+                    buffer.store(r, std::memory_order_release);
+                    return r;
+                }
+
+                alignas(64) std::atomic<std::int64_t> top = 0;
+                alignas(64) std::atomic<std::int64_t> bottom = 0;
+                alignas(64) std::atomic<ring*> buffer = nullptr;
+
+                std::vector<std::unique_ptr<ring>> retired;
+        };
+    }
+
+    class thread_pool
+    {
+        public:
+            explicit thread_pool(std::size_t thread_count = std::thread::hardware_concurrency())
+            {
+                if (thread_count == 0)
+                    thread_count = 1;
+
+                workers.reserve(thread_count);
+                for (std::size_t i = 0; i < thread_count; ++i)
+                    workers.push_back(std::make_unique<worker>(0x9e3779b97f4a7c15ULL * (i + 1)));
+
+                threads.reserve(thread_count);
+                for (std::size_t i = 0; i < thread_count; ++i)
+                    threads.emplace_back([this, i] { worker_loop(i); });
+            }
+
+            // Runs every task that has been submitted before joining the workers
+            ~thread_pool()
+            {
+                stopping.store(true, std::memory_order_seq_cst);
+                wake_epoch.fetch_add(1, std::memory_order_release);
+                wake_epoch.notify_all();
+
+                for (std::thread& t : threads)
+                    t.join();
+            }
+
+            thread_pool(const thread_pool&) = delete;
+            thread_pool& operator=(const thread_pool&) = delete;
+
+            [[nodiscard]] std::size_t size() const noexcept { return workers.size(); }
+
+            // Tasks submitted from a worker of this pool go to the worker's own
+            // deque, everything else goes through the shared injection queue.
+            // Exceptions escaping a task terminate the program.
+            template <typename F>
+            void submit(F&& fn)
+            {
+                push_task(new detail::pool_task_impl<std::decay_t<F>>(FTL_FORWARD(fn)));
+            }
+
+            // Runs a single pending task on the calling thread if one is found,
+            // used for helping out while waiting on tasks from inside the pool
+            bool run_pending_task()
+            {
+                detail::pool_task* task = find_task(current_worker_index());
+                if (task == nullptr)
+                    return false;
+
+                execute(task);
+                return true;
+            }
+
+            // true if called from one of this pool's worker threads
+            [[nodiscard]] bool is_worker_thread() const noexcept { return current_pool() == this; }
+
+        private:
+            struct alignas(64) worker
+            {
+                explicit worker(std::uint64_t seed) noexcept : rng_state(seed) {}
+
+                detail::work_stealing_deque tasks;
+                std::uint64_t rng_state;
+            };
+
+            constexpr static std::size_t no_worker = static_cast<std::size_t>(-1);
+            constexpr static int spin_count = 64;
+
+            static const thread_pool*& current_pool() noexcept {
+                thread_local const thread_pool* pool = nullptr;
+                return pool;
+            }
+
+            static std::size_t& current_index() noexcept {
+                thread_local std::size_t index = no_worker;
+                return index;
+            }
+
+            std::size_t current_worker_index() const noexcept {
+                return current_pool() == this ? current_index() : no_worker;
+            }
+
+            void push_task(detail::pool_task* task)
+            {
+                const std::size_t index = current_worker_index();
+                if (index != no_worker) {
+                    workers[index]->tasks.push(task);
+                } else {
+                    std::lock_guard<std::mutex> lock(injection_mutex);
+                    injection_queue.push_back(task);
+                    injection_size.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                // pairs with the seq_cst increment of sleeping in worker_loop, either
+                // the sleeper sees the new task or we see the sleeper
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (sleeping.load(std::memory_order_relaxed) != 0) {
+                    wake_epoch.fetch_add(1, std::memory_order_release);
+                    wake_epoch.notify_one();
+                }
+            }
+
+            detail::pool_task* pop_injected()
+            {
+                if (injection_size.load(std::memory_order_relaxed) == 0)
+                    return nullptr;
+
+                std::lock_guard<std::mutex> lock(injection_mutex);
+                if (injection_queue.empty())
+                    return nullptr;
+
+                detail::pool_task* task = injection_queue.front();
+                injection_queue.pop_front();
+                injection_size.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+
+            detail::pool_task* steal_from_others(std::size_t self)
+            {
+                const std::size_t count = workers.size();
+                std::size_t start = 0;
+
+                if (self != no_worker) {
+                    // xorshift64
+                    std::uint64_t& x = workers[self]->rng_state;
+                    x ^= x << 13;
+                    x ^= x >> 7;
+                    x ^= x << 17;
+                    start = static_cast<std::size_t>(x % count);
+                }
+
+                for (std::size_t i = 0; i < count; ++i) {
+                    const std::size_t victim = (start + i) % count;
+                    if (victim == self)
+                        continue;
+
+                    if (detail::pool_task* task = workers[victim]->tasks.steal())
+                        return task;
+                }
+                return nullptr;
+            }
+
+            detail::pool_task* find_task(std::size_t self)
+            {
+                if (self != no_worker)
+                    if (detail::pool_task* task = workers[self]->tasks.take())
+                        return task;
+
+                if (detail::pool_task* task = pop_injected())
+                    return task;
+
+                return steal_from_others(self);
+            }
+
+            static void execute(detail::pool_task* task)
+            {
+                std::unique_ptr<detail::pool_task> owned(task);
+                owned->run();
+            }
+
+            void worker_loop(std::size_t index)
+            {
+                current_pool() = this;
+                current_index() = index;
+
+                for (;;) {
+                    detail::pool_task* task = nullptr;
+                    for (int spin = 0; spin < spin_count && task == nullptr; ++spin)
+                        task = find_task(index);
+
+                    if (task != nullptr) {
+                        execute(task);
+                        continue;
+                    }
+
+                    const std::uint32_t epoch = wake_epoch.load(std::memory_order_acquire);
+                    sleeping.fetch_add(1, std::memory_order_seq_cst);
+
+                    // anything pushed before the increment above is visible now
+                    task = find_task(index);
+                    if (task == nullptr && stopping.load(std::memory_order_seq_cst)) {
+                        sleeping.fetch_sub(1, std::memory_order_relaxed);
+                        return;
+                    }
+
+                    if (task == nullptr)
+                        wake_epoch.wait(epoch, std::memory_order_acquire);
+
+                    sleeping.fetch_sub(1, std::memory_order_relaxed);
+
+                    if (task != nullptr)
+                        execute(task);
+                }
+            }
+
+            std::vector<std::unique_ptr<worker>> workers;
+            std::vector<std::thread> threads;
+
+            std::mutex injection_mutex;
+            std::deque<detail::pool_task*> injection_queue;
+
+            alignas(64) std::atomic<std::size_t> injection_size = 0;
+            alignas(64) std::atomic<std::uint32_t> wake_epoch = 0;
+            alignas(64) std::atomic<std::uint32_t> sleeping = 0;
+            std::atomic<bool> stopping = false;
+    };
+
+    namespace detail {
+        struct parallel_for_state
+        {
+            std::atomic<std::size_t> remaining;
+            std::atomic<bool> failed = false;
+            std::exception_ptr exception;
+
+            explicit parallel_for_state(std::size_t count) noexcept : remaining(count) {}
+
+            void complete(std::size_t count) noexcept {
+                if (remaining.fetch_sub(count, std::memory_order_acq_rel) == count)
+                    remaining.notify_all();
+            }
+        };
+
+        // Splits the range in halves, handing the upper half to the pool until
+        // the range is at most grain sized, so that idle workers steal big
+        // chunks from the top of the deque while the owner works on small ones.
+        template <typename Index, typename F>
+        void parallel_for_split(thread_pool& pool, const std::shared_ptr<parallel_for_state>& state,
+                                Index first, Index last, Index grain, F* fn)
+        {
+            while (last - first > grain) {
+                const Index mid = first + (last - first) / 2;
+                pool.submit([&pool, state, mid, last, grain, fn] {
+                    parallel_for_split(pool, state, mid, last, grain, fn);
+                });
+                last = mid;
+            }
+
+            if (not state->failed.load(std::memory_order_relaxed)) {
+                #ifdef __cpp_exceptions
+                try {
+                    for (Index i = first; i != last; ++i)
+                        (*fn)(i);
+                } catch (...) {
+                    if (not state->failed.exchange(true, std::memory_order_acq_rel))
+                        state->exception = std::current_exception();
+                }
+                #else
+                for (Index i = first; i != last; ++i)
+                    (*fn)(i);
+                #endif
+            }
+
+            state->complete(static_cast<std::size_t>(last - first));
+        }
+    }
+
+    // Calls fn(i) for every i in [first, last) on the pool and returns when all
+    // calls have finished.  If grain is zero, it is picked so that every worker
+    // gets a handful of chunks.  The first exception thrown by fn is rethrown
+    // to the caller, the remaining chunks are skipped.
+    template <typename Index, typename F> requires std::is_integral_v<Index>
+    void parallel_for(thread_pool& pool, Index first, Index last, F&& fn, Index grain = 0)
+    {
+        if (last <= first)
+            return;
+
+        const std::size_t count = static_cast<std::size_t>(last - first);
+        if (grain == 0)
+            grain = static_cast<Index>(count / (pool.size() * 8) + 1);
+
+        auto state = std::make_shared<detail::parallel_for_state>(count);
+        std::remove_reference_t<F>* fn_ptr = &fn;
+
+        if (pool.is_worker_thread()) {
+            detail::parallel_for_split(pool, state, first, last, grain, fn_ptr);
+            while (state->remaining.load(std::memory_order_acquire) != 0)
+                if (not pool.run_pending_task())
+                    std::this_thread::yield();
+        } else {
+            pool.submit([&pool, state, first, last, grain, fn_ptr] {
+                detail::parallel_for_split(pool, state, first, last, grain, fn_ptr);
+            });
+
+            std::size_t remaining = state->remaining.load(std::memory_order_acquire);
+            while (remaining != 0) {
+                state->remaining.wait(remaining, std::memory_order_acquire);
+                remaining = state->remaining.load(std::memory_order_acquire);
+            }
+        }
+
+        #ifdef __cpp_exceptions
+        if (state->exception)
+            std::rethrow_exception(state->exception);
+        #endif
+    }
+}
+
+#endif
+#endif
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
@@ -0,0 +1,166 @@
+#ifndef FTL_TIMESERIES_RING_HPP
+#define FTL_TIMESERIES_RING_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+#include "utility.hpp"
+#include "soa_ring_buffer.hpp"
+
+namespace ftl
+{
+    // Samples of a timeseries_ring, timestamps and values as at most two
+    // contiguous segments each, split at the same index
+    template <typename T, typename Timestamp>
+    struct timeseries_range
+    {
+        ring_buffer_segments<const Timestamp> times;
+        ring_buffer_segments<const T> values;
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return times.size(); }
+        [[nodiscard]] constexpr bool empty() const noexcept { return times.empty(); }
+    };
+
+    namespace detail {
+        // Index of the first element not less than value in a sorted array
+        template <typename U, typename V>
+        constexpr std::size_t lower_bound_index(const U* data, std::size_t count, const V& value) noexcept {
+            std::size_t first = 0;
+            while (count > 0) {
+                const std::size_t half = count / 2;
+                if (data[first + half] < value) {
+                    first += half + 1;
+                    count -= half + 1;
+                } else {
+                    count = half;
+                }
+            }
+            return first;
+        }
+
+        // Elements [begin, end) of segments, as segments
+        template <typename U>
+        constexpr ring_buffer_segments<U> slice_segments(const ring_buffer_segments<U>& seg, std::size_t begin, std::size_t end) noexcept {
+            const std::size_t split = seg.first.size();
+            if (begin >= split)
+                return { { seg.second.data() + (begin - split), end - begin }, {} };
+            if (end <= split)
+                return { { seg.first.data() + begin, end - begin }, {} };
+            return {
+                { seg.first.data() + begin, split - begin },
+                { seg.second.data(), end - split }
+            };
+        }
+    }
+
+    // Ring buffer of samples ordered by a monotonic timestamp, which is kept in
+    // its own column so that the range queries binary search only timestamps.
+    // Timestamps must not decrease, pushing an older sample than the newest
+    // one is a precondition violation.
+    template <typename T, typename Timestamp = std::uint64_t, typename Storage = FTL_DEFAULT_SOA_STORAGE>
+    class timeseries_ring
+    {
+        using samples_type = basic_soa_ring_buffer<Storage, Timestamp, T>;
+
+        public:
+            using value_type        = T;
+            using time_type         = Timestamp;
+            using size_type         = std::size_t;
+            using range_type        = timeseries_range<T, Timestamp>;
+
+            constexpr static bool is_dynamic = samples_type::is_dynamic;
+
+            // modifiers
+            template <typename U> requires std::is_convertible_v<U, T>
+            constexpr void push(const Timestamp& time, U&& value) {
+                assert(is_empty() || not (time < latest()));
+                samples.push(time, FTL_FORWARD(value));
+            }
+
+            template <typename U> requires std::is_convertible_v<U, T>
+            constexpr void push_overwrite(const Timestamp& time, U&& value) {
+                assert(is_empty() || not (time < latest()));
+                samples.push_overwrite(time, FTL_FORWARD(value));
+            }
+
+            // Removes the samples older than time and returns how many were removed
+            constexpr size_type evict_before(const Timestamp& time) noexcept {
+                const size_type count = lower_bound(time);
+                samples.discard(count);
+                return count;
+            }
+
+            constexpr void reserve(size_type count) { samples.reserve(count); }
+            constexpr void clear() noexcept { samples.clear(); }
+
+            // range queries, O(log n)
+            [[nodiscard]] constexpr range_type since(const Timestamp& time) const noexcept {
+                return slice(lower_bound(time), size());
+            }
+
+            // Samples from t0 up to but not including t1
+            [[nodiscard]] constexpr range_type between(const Timestamp& t0, const Timestamp& t1) const noexcept {
+                const size_type begin = lower_bound(t0);
+                const size_type end = lower_bound(t1);
+                return slice(begin, end < begin ? begin : end);
+            }
+
+            [[nodiscard]] constexpr range_type all() const noexcept { return slice(0, size()); }
+
+            // Index of the oldest sample not older than time, size() if there is none
+            [[nodiscard]] constexpr size_type lower_bound(const Timestamp& time) const noexcept {
+                const ring_buffer_segments<const Timestamp> times = samples.template column<0>();
+
+                // the first segment holds the older samples, search the second
+                // one only if all of the first one is older
+                if (times.first.empty() || times.first[times.first.size() - 1] < time)
+                    return times.first.size() + detail::lower_bound_index(times.second.data(), times.second.size(), time);
+                return detail::lower_bound_index(times.first.data(), times.first.size(), time);
+            }
+
+            // element access, index is relative to the oldest sample
+            [[nodiscard]] constexpr const Timestamp& time(size_type index) const noexcept { return samples.template get<0>(index); }
+            [[nodiscard]] constexpr T& value(size_type index) noexcept { return samples.template get<1>(index); }
+            [[nodiscard]] constexpr const T& value(size_type index) const noexcept { return samples.template get<1>(index); }
+
+            [[nodiscard]] constexpr const Timestamp& oldest() const noexcept { return samples.template front<0>(); }
+            [[nodiscard]] constexpr const Timestamp& latest() const noexcept { return samples.template back<0>(); }
+
+            // queries
+            [[nodiscard]] constexpr size_type size() const noexcept { return samples.size(); }
+            [[nodiscard]] constexpr size_type capacity() const noexcept { return samples.capacity(); }
+            [[nodiscard]] constexpr bool is_empty() const noexcept { return samples.is_empty(); }
+            [[nodiscard]] constexpr bool is_full() const noexcept { return samples.is_full(); }
+
+        private:
+            constexpr range_type slice(size_type begin, size_type end) const noexcept {
+                return {
+                    detail::slice_segments(samples.template column<0>(), begin, end),
+                    detail::slice_segments(samples.template column<1>(), begin, end)
+                };
+            }
+
+            samples_type samples;
+    };
+}
+
+#endif
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
@@ -0,0 +1,282 @@
+#ifndef FTL_TRACE_HPP
+#define FTL_TRACE_HPP
+
+// Needs threads, clocks and iostreams, so this header is empty in
+// freestanding environments.
+#if __STDC_HOSTED__ == 1
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(FTL_TRACE_NO_RDTSC)
+# include <x86intrin.h>
+# define FTL_TRACE_USE_RDTSC
+#endif
+
+#include "utility.hpp"
+#include "ring_buffer.hpp"
+
+namespace ftl
+{
+    // Event types, the values are the Chrome trace event phases
+    enum class trace_phase : std::uint8_t
+    {
+        instant     = 'i',
+        begin       = 'B',
+        end         = 'E',
+        counter     = 'C',
+    };
+
+    // Compact binary event, the timestamp is in clock ticks of trace_timestamp()
+    struct trace_event
+    {
+        std::uint64_t   timestamp;
+        std::uint64_t   payload;
+        std::uint32_t   name;
+        trace_phase     phase;
+    };
+
+    // Raw timestamp, TSC ticks on x86-64 with an invariant TSC (define
+    // FTL_TRACE_NO_RDTSC if yours is not), steady_clock nanoseconds elsewhere
+    inline std::uint64_t trace_timestamp() noexcept {
+        #ifdef FTL_TRACE_USE_RDTSC
+            return __rdtsc();
+        #else
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        #endif
+    }
+
+    namespace detail {
+        inline std::uint64_t trace_clock_ns() noexcept {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        // Events of one thread, the lock is only ever contended while dumping
+        struct trace_thread_buffer
+        {
+            explicit trace_thread_buffer(std::uint32_t tid, std::size_t capacity) : tid(tid) {
+                events.reserve(capacity);
+            }
+
+            void lock() noexcept {
+                while (busy.test_and_set(std::memory_order_acquire))
+                    ;
+            }
+            void unlock() noexcept { busy.clear(std::memory_order_release); }
+
+            ring_buffer<trace_event, std::allocator<trace_event>> events;
+            std::atomic_flag busy;
+            std::atomic<bool> exited { false };
+            const std::uint32_t tid;
+        };
+
+        struct trace_registry
+        {
+            trace_registry() : start_ticks(trace_timestamp()), start_ns(trace_clock_ns()) {}
+
+            std::mutex mutex;
+            std::vector<std::shared_ptr<trace_thread_buffer>> buffers;
+            std::vector<std::string> names;
+            std::unordered_map<std::string, std::uint32_t> name_ids;
+            std::size_t capacity = 4096;
+            std::uint32_t next_tid = 1;
+
+            // ticks and nanoseconds at the same moment, for converting ticks
+            const std::uint64_t start_ticks;
+            const std::uint64_t start_ns;
+        };
+
+        inline trace_registry& get_trace_registry() {
+            static trace_registry registry;
+            return registry;
+        }
+
+        // Keeps the buffer of a thread alive in the registry after the thread exits
+        struct trace_thread_handle
+        {
+            trace_thread_handle() {
+                trace_registry& registry = get_trace_registry();
+                std::lock_guard lock(registry.mutex);
+                buffer = std::make_shared<trace_thread_buffer>(registry.next_tid++, registry.capacity);
+                registry.buffers.push_back(buffer);
+            }
+
+            ~trace_thread_handle() { buffer->exited.store(true, std::memory_order_relaxed); }
+
+            std::shared_ptr<trace_thread_buffer> buffer;
+        };
+
+        inline trace_thread_buffer& get_thread_trace_buffer() {
+            thread_local trace_thread_handle handle;
+            return *handle.buffer;
+        }
+
+        inline void write_json_string(std::ostream& out, std::string_view str) {
+            constexpr char hex[] = "0123456789abcdef";
+            out << '"';
+            for (char c : str) {
+                const unsigned char uc = static_cast<unsigned char>(c);
+                if (c == '"' || c == '\\')
+                    out << '\\' << c;
+                else if (uc < 0x20)
+                    out << "\\u00" << hex[uc >> 4] << hex[uc & 0xf];
+                else
+                    out << c;
+            }
+            out << '"';
+        }
+    }
+
+    // Sets the number of events kept per thread, for threads that have not traced yet
+    inline void trace_set_capacity(std::size_t events_per_thread) {
+        detail::trace_registry& registry = detail::get_trace_registry();
+        std::lock_guard lock(registry.mutex);
+        registry.capacity = events_per_thread == 0 ? 1 : events_per_thread;
+    }
+
+    // Returns the id of a name, interning it on first use.  Takes a lock, so
+    // keep the result, e.g. in a function-local static.
+    inline std::uint32_t trace_intern(std::string_view name) {
+        detail::trace_registry& registry = detail::get_trace_registry();
+        std::lock_guard lock(registry.mutex);
+
+        auto it = registry.name_ids.find(std::string(name));
+        if (it != registry.name_ids.end())
+            return it->second;
+
+        const std::uint32_t id = static_cast<std::uint32_t>(registry.names.size());
+        registry.names.emplace_back(name);
+        registry.name_ids.emplace(registry.names.back(), id);
+        return id;
+    }
+
+    // Records an event in the calling thread's buffer, overwriting the oldest
+    // one when full.  The first event of a thread allocates its buffer.
+    inline void trace_record(std::uint32_t name, trace_phase phase, std::uint64_t payload = 0) {
+        detail::trace_thread_buffer& buffer = detail::get_thread_trace_buffer();
+        const std::uint64_t timestamp = trace_timestamp();
+
+        buffer.lock();
+        buffer.events.push_overwrite(trace_event { timestamp, payload, name, phase });
+        buffer.unlock();
+    }
+
+    inline void trace_instant(std::uint32_t name, std::uint64_t payload = 0) { trace_record(name, trace_phase::instant, payload); }
+    inline void trace_counter(std::uint32_t name, std::uint64_t value) { trace_record(name, trace_phase::counter, value); }
+    inline void trace_begin(std::uint32_t name, std::uint64_t payload = 0) { trace_record(name, trace_phase::begin, payload); }
+    inline void trace_end(std::uint32_t name) { trace_record(name, trace_phase::end); }
+
+    // Begin and end events around a scope
+    class trace_scope
+    {
+        public:
+            explicit trace_scope(std::uint32_t name, std::uint64_t payload = 0) : name(name) { trace_begin(name, payload); }
+            ~trace_scope() { trace_end(name); }
+
+            trace_scope(const trace_scope&) = delete;
+            trace_scope& operator=(const trace_scope&) = delete;
+
+        private:
+            std::uint32_t name;
+    };
+
+    // Empties all buffers and forgets the ones of exited threads
+    inline void trace_clear() {
+        detail::trace_registry& registry = detail::get_trace_registry();
+        std::lock_guard lock(registry.mutex);
+
+        std::erase_if(registry.buffers, [](const auto& buffer) { return buffer->exited.load(std::memory_order_relaxed); });
+        for (auto& buffer : registry.buffers) {
+            buffer->lock();
+            buffer->events.clear();
+            buffer->unlock();
+        }
+    }
+
+    // Writes the recorded events of all threads as Chrome trace event JSON,
+    // which chrome://tracing and Perfetto load.  Threads keep recording while
+    // this runs, each one waits at most for its own buffer to be copied.
+    inline void trace_dump_chrome_json(std::ostream& out) {
+        detail::trace_registry& registry = detail::get_trace_registry();
+
+        std::vector<std::shared_ptr<detail::trace_thread_buffer>> buffers;
+        std::vector<std::string> names;
+        {
+            std::lock_guard lock(registry.mutex);
+            buffers = registry.buffers;
+            names = registry.names;
+        }
+
+        // ticks per nanosecond since the registry was created
+        const std::uint64_t ticks = trace_timestamp() - registry.start_ticks;
+        const std::uint64_t ns = detail::trace_clock_ns() - registry.start_ns;
+        const double ns_per_tick = ticks == 0 || ns == 0 ? 1.0 : static_cast<double>(ns) / static_cast<double>(ticks);
+
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        std::vector<trace_event> events;
+
+        for (const auto& buffer : buffers) {
+            events.clear();
+            buffer->lock();
+            const auto segments = buffer->events.segments();
+            events.insert(events.end(), segments.first.begin(), segments.first.end());
+            events.insert(events.end(), segments.second.begin(), segments.second.end());
+            buffer->unlock();
+
+            for (const trace_event& event : events) {
+                const std::int64_t delta = static_cast<std::int64_t>(event.timestamp - registry.start_ticks);
+                const double us = static_cast<double>(delta) * ns_per_tick / 1000.0;
+
+                out << (first ? "\n" : ",\n") << "{\"name\":";
+                first = false;
+                detail::write_json_string(out, event.name < names.size() ? std::string_view(names[event.name]) : std::string_view("?"));
+                out << ",\"ph\":\"" << static_cast<char>(event.phase) << "\",\"ts\":" << std::to_string(us)
+                    << ",\"pid\":1,\"tid\":" << buffer->tid;
+
+                if (event.phase == trace_phase::instant)
+                    out << ",\"s\":\"t\"";
+                if (event.phase == trace_phase::counter)
+                    out << ",\"args\":{\"value\":" << event.payload << "}}";
+                else if (event.phase != trace_phase::end)
+                    out << ",\"args\":{\"payload\":" << event.payload << "}}";
+                else
+                    out << "}";
+            }
+        }
+
+        out << "\n]}\n";
+    }
+}
+
+#endif
+#endif
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
@@ -47,6 +47,15 @@ namespace ftl::detail
 #define FTL_FORWARD(...) \
     static_cast<decltype(__VA_ARGS__)&&>(__VA_ARGS__)
 
+// Placed right before a loop whose iterations do not depend on each other,
+// lets the compiler vectorise it without runtime alias checks.  GCC warns
+// about ivdep on loops it unrolls completely, so it gets the alias checks.
+#if defined(__clang__)
+# define FTL_VECTORISE _Pragma("clang loop vectorize(assume_safety)")
+#else
+# define FTL_VECTORISE
+#endif
+
 #endif
 /*
     Copyright 2022 Jari Ronkainen
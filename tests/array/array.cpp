@@ -105,6 +105,52 @@ TEST_SUITE("ftl::array") {
         CHECK(c_int_as_array[3] == ftl_array_as_int_ptr[3]);
     }
 
+    TEST_CASE("Comparison and fill") {
+        SUBCASE("Byte arrays") {
+            ftl::array<uint8_t, 4096> a;
+            ftl::array<uint8_t, 4096> b;
+            a.fill(0xab);
+            b.fill(0xab);
+            CHECK(a == b);
+            CHECK(a[4095] == 0xab);
+
+            b[4095] = 0;
+            CHECK(not (a == b));
+            b[4095] = 0xab;
+            b[0] = 0;
+            CHECK(not (a == b));
+        }
+
+        SUBCASE("Values with uniform and mixed bytes") {
+            ftl::array<int, 3, 5> a;
+            a.fill(-1);
+            CHECK(a.at(2, 4) == -1);
+            a.fill(0);
+            CHECK(a.at(1, 3) == 0);
+            a.fill(0x01020304);
+            CHECK(a.at(0, 0) == 0x01020304);
+            CHECK(a.at(2, 4) == 0x01020304);
+        }
+
+        SUBCASE("Floating point compares values, not bytes") {
+            ftl::array<float, 2> a { 0.0f, 1.0f };
+            ftl::array<float, 2> b { -0.0f, 1.0f };
+            CHECK(a == b);
+            a.fill(2.5f);
+            CHECK(a[1] == 2.5f);
+        }
+
+        SUBCASE("Constant evaluation") {
+            constexpr auto filled = [] {
+                ftl::array<int, 4> a;
+                a.fill(7);
+                return a;
+            }();
+            static_assert(filled == ftl::array<int, 4> { 7, 7, 7, 7 });
+            CHECK(filled[3] == 7);
+        }
+    }
+
     TEST_CASE("Multidimensional access overhead") {
         SUBCASE("Two-dimensional case") {
             using counter_type = ftl_test::counted_ctr_dtr<"array-access-0">;
@@ -152,6 +198,44 @@ TEST_SUITE("ftl::array") {
             CHECK(counter_type::destroyed == 0);
         }
     }
+
+    TEST_CASE("Multi-index subscripts") {
+        ftl::array<int, 3, 4, 5> cube;
+        for (std::size_t i = 0; i < cube.size(); ++i)
+            cube.data()[i] = static_cast<int>(i);
+
+        SUBCASE("All forms refer to the same element") {
+            CHECK(&cube(2, 3, 4) == &cube.at(2, 3, 4));
+            CHECK(&cube[2][3][4] == &cube.at(2, 3, 4));
+            CHECK(cube(1, 2, 3) == 1 * 20 + 2 * 5 + 3);
+            #ifdef __cpp_multidimensional_subscript
+            CHECK(&cube[2, 3, 4] == &cube.at(2, 3, 4));
+            #endif
+
+            const auto& ccube = cube;
+            CHECK(&ccube(0, 1, 2) == &cube.at(0, 1, 2));
+            static_assert(std::is_same_v<decltype(ccube(0, 1, 2)), const int&>);
+            static_assert(std::is_same_v<decltype(ccube[0][1][2]), const int&>);
+        }
+
+        SUBCASE("Proxies can be kept as lvalues") {
+            auto plane = cube[1];
+            auto row = plane[2];
+            row[3] = -1;
+            CHECK(cube.at(1, 2, 3) == -1);
+
+            const auto& ccube = cube;
+            auto crow = ccube[1][2];
+            CHECK(crow[3] == -1);
+        }
+
+        SUBCASE("Constant evaluation") {
+            constexpr ftl::array<int, 2, 3> grid(0, 1, 2, 3, 4, 5);
+            static_assert(grid(1, 2) == 5);
+            static_assert(grid[1][0] == 3);
+            CHECK(grid(0, 1) == 1);
+        }
+    }
 }
 /*
     Copyright 2022 Jari Ronkainen
@@ -0,0 +1,220 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <type_traits>
+#include <cfenv>
+#include <limits>
+#include <ftl/array_ops.hpp>
+
+namespace {
+    // Writes 0, 1, 2, ... in row-major index order through at()
+    template <typename Layout, std::size_t R, std::size_t C>
+    constexpr ftl::basic_array<int, Layout, R, C> numbered() {
+        ftl::basic_array<int, Layout, R, C> grid;
+        for (std::size_t r = 0; r < R; ++r)
+            for (std::size_t c = 0; c < C; ++c)
+                grid.at(r, c) = static_cast<int>(r * C + c);
+        return grid;
+    }
+
+    // Each value is stored exactly once and indexing agrees with at()
+    template <typename Layout, std::size_t R, std::size_t C>
+    void check_layout() {
+        auto grid = numbered<Layout, R, C>();
+
+        bool seen[R * C] = {};
+        for (int value : grid) {
+            REQUIRE(value >= 0);
+            REQUIRE(value < static_cast<int>(R * C));
+            CHECK(not seen[value]);
+            seen[value] = true;
+        }
+
+        for (std::size_t r = 0; r < R; ++r)
+            for (std::size_t c = 0; c < C; ++c)
+                CHECK(grid[r][c] == static_cast<int>(r * C + c));
+    }
+}
+
+TEST_SUITE("ftl::array layouts") {
+    TEST_CASE("Indexing is the same under every layout") {
+        check_layout<ftl::row_major, 3, 5>();
+        check_layout<ftl::column_major, 3, 5>();
+        check_layout<ftl::tiled<2, 4>, 4, 8>();
+        check_layout<ftl::morton, 4, 4>();
+        check_layout<ftl::morton, 2, 8>();
+    }
+
+    TEST_CASE("Storage order") {
+        SUBCASE("Row-major matches C arrays") {
+            auto grid = numbered<ftl::row_major, 2, 3>();
+            CHECK(grid.data()[3] == 3);
+            CHECK(grid[1][0] == 3);
+        }
+
+        SUBCASE("Column-major stores columns contiguously") {
+            auto grid = numbered<ftl::column_major, 2, 3>();
+            const int expected[] = { 0, 3, 1, 4, 2, 5 };
+            for (std::size_t i = 0; i < 6; ++i)
+                CHECK(grid.data()[i] == expected[i]);
+        }
+
+        SUBCASE("Tiles are stored one after another") {
+            auto grid = numbered<ftl::tiled<2, 2>, 4, 4>();
+            const int expected[] = { 0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15 };
+            for (std::size_t i = 0; i < 16; ++i)
+                CHECK(grid.data()[i] == expected[i]);
+        }
+
+        SUBCASE("Morton order interleaves the index bits") {
+            auto grid = numbered<ftl::morton, 4, 4>();
+            const int expected[] = { 0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15 };
+            for (std::size_t i = 0; i < 16; ++i)
+                CHECK(grid.data()[i] == expected[i]);
+        }
+    }
+
+    TEST_CASE("Three dimensions") {
+        ftl::basic_array<int, ftl::morton, 2, 4, 2> cube;
+        ftl::basic_array<int, ftl::tiled<1, 2, 2>, 2, 4, 2> tiles;
+        ftl::array<int, 2, 4, 2> plain;
+
+        int n = 0;
+        for (std::size_t i = 0; i < 2; ++i)
+            for (std::size_t j = 0; j < 4; ++j)
+                for (std::size_t k = 0; k < 2; ++k, ++n) {
+                    cube.at(i, j, k) = n;
+                    tiles.at(i, j, k) = n;
+                    plain.at(i, j, k) = n;
+                }
+
+        CHECK(plain.data()[13] == 13);
+        for (std::size_t i = 0; i < 2; ++i)
+            for (std::size_t j = 0; j < 4; ++j)
+                for (std::size_t k = 0; k < 2; ++k) {
+                    CHECK(cube[i][j][k] == plain.at(i, j, k));
+                    CHECK(tiles[i][j][k] == plain.at(i, j, k));
+                }
+    }
+
+    TEST_CASE("Views of column-major arrays") {
+        auto grid = numbered<ftl::column_major, 3, 4>();
+
+        auto row = grid.row(1);
+        CHECK(row.stride(0) == 3);
+        CHECK(row[2] == 6);
+
+        auto col = grid.col(2);
+        CHECK(col.stride(0) == 1);
+        CHECK(col[1] == 6);
+
+        auto block = grid.block<2, 2>(1, 1);
+        CHECK(block.at(1, 1) == 10);
+    }
+
+    TEST_CASE("Element-wise operations keep the layout") {
+        auto a = numbered<ftl::morton, 4, 4>();
+        auto b = numbered<ftl::morton, 4, 4>();
+
+        auto c = ftl::eval(a + b * 2);
+        CHECK(std::is_same_v<decltype(c), ftl::basic_array<int, ftl::morton, 4, 4>>);
+        CHECK(c.at(3, 1) == 39);
+        CHECK(ftl::sum(c) == 3 * 120);
+        CHECK(c == ftl::eval(a * 3));
+    }
+
+    TEST_CASE("Layouts in constant expressions") {
+        constexpr auto grid = numbered<ftl::tiled<2, 2>, 4, 4>();
+        static_assert(grid.at(2, 3) == 11);
+        static_assert(grid[3][0] == 12);
+        CHECK(grid.at(1, 2) == 6);
+    }
+
+    TEST_CASE("Aligned layout") {
+        using aligned_floats = ftl::basic_array<float, ftl::aligned<32>, 3, 5>;
+        using aligned_ints = ftl::basic_array<int, ftl::aligned<64, ftl::column_major>, 3, 3>;
+
+        static_assert(alignof(aligned_floats) == 32);
+        static_assert(aligned_floats::size() == 15);
+        static_assert(aligned_floats::storage_size() == 16);
+        static_assert(aligned_ints::storage_size() == 16);
+        static_assert(ftl::array<float, 3, 5>::storage_size() == 15);
+        static_assert(std::is_trivially_default_constructible_v<ftl::array<float, 3, 5>>);
+
+        check_layout<ftl::aligned<32>, 3, 5>();
+        check_layout<ftl::aligned<64, ftl::column_major>, 3, 3>();
+
+        aligned_floats a;
+        aligned_floats b;
+        CHECK(reinterpret_cast<std::uintptr_t>(a.data()) % 32 == 0);
+
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            a.data()[i] = static_cast<float>(i);
+            b.data()[i] = 2.0f;
+        }
+
+        // the padding takes part in a * b, but not in the results
+        aligned_floats c = a * b + 1.0f;
+        CHECK(c.at(2, 4) == 29.0f);
+        CHECK(ftl::sum(c) == 15.0f * 14.0f + 15.0f);
+        CHECK(ftl::max_value(c / b) == 14.5f);
+        CHECK(c == ftl::eval(a + a + 1.0f));
+
+        // integer operands keep the loop out of the padding
+        ftl::basic_array<int, ftl::aligned<32>, 3, 5> counts;
+        counts.fill(3);
+        aligned_floats d = a + counts;
+        CHECK(d.at(2, 4) == 17.0f);
+
+        ftl::basic_array<double, ftl::aligned<32>, 3, 5> wide = a * 2.0;
+        CHECK(wide.at(2, 4) == 28.0);
+
+        CHECK(a.row(1)[2] == 7.0f);
+        CHECK(aligned_ints(1, 2, 3, 4, 5, 6, 7, 8, 9).at(1, 0) == 2);
+    }
+
+    TEST_CASE("Aligned padding stays zero and raises nothing") {
+        using aligned_floats = ftl::basic_array<float, ftl::aligned<32>, 5>;
+        static_assert(aligned_floats::storage_size() == 8);
+
+        aligned_floats a;
+        aligned_floats b;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            a.at(i) = 1.0f;
+            b.at(i) = 2.0f;
+        }
+
+        std::feclearexcept(FE_ALL_EXCEPT);
+        aligned_floats r = a / b;
+        aligned_floats s = a * b - b;
+        aligned_floats t = a * std::numeric_limits<float>::infinity();
+        CHECK(std::fetestexcept(FE_INVALID | FE_DIVBYZERO) == 0);
+
+        CHECK(r.at(4) == 0.5f);
+        CHECK(s.at(4) == 0.0f);
+        CHECK(t.at(4) == std::numeric_limits<float>::infinity());
+        for (std::size_t i = a.size(); i < a.storage_size(); ++i) {
+            CHECK(r.data()[i] == 0.0f);
+            CHECK(s.data()[i] == 0.0f);
+            CHECK(t.data()[i] == 0.0f);
+        }
+    }
+}
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
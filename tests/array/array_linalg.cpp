@@ -0,0 +1,123 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <type_traits>
+#include <ftl/array_linalg.hpp>
+
+namespace {
+    template <std::size_t R, std::size_t C>
+    ftl::array<double, R, C> pseudo_random(unsigned seed) {
+        ftl::array<double, R, C> result;
+        for (double& value : result) {
+            seed = seed * 1103515245u + 12345u;
+            value = static_cast<double>((seed >> 16) % 17) - 8.0;
+        }
+        return result;
+    }
+
+    template <std::size_t M, std::size_t K, std::size_t N>
+    ftl::array<double, M, N> naive_matmul(const ftl::array<double, M, K>& a, const ftl::array<double, K, N>& b) {
+        ftl::array<double, M, N> result;
+        for (std::size_t i = 0; i < M; ++i)
+            for (std::size_t j = 0; j < N; ++j) {
+                double sum = 0.0;
+                for (std::size_t k = 0; k < K; ++k)
+                    sum += a.at(i, k) * b.at(k, j);
+                result.at(i, j) = sum;
+            }
+        return result;
+    }
+}
+
+TEST_SUITE("ftl::array matrix operations") {
+    TEST_CASE("Small matrix product") {
+        ftl::array<float, 2, 3> a { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+        ftl::array<float, 3, 2> b { 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f };
+
+        auto c = ftl::matmul(a, b);
+        CHECK(std::is_same_v<decltype(c), ftl::array<float, 2, 2>>);
+        CHECK(c == ftl::array<float, 2, 2> { 58.0f, 64.0f, 139.0f, 154.0f });
+    }
+
+    TEST_CASE("Identity") {
+        ftl::array<float, 4, 4> identity {};
+        for (std::size_t i = 0; i < 4; ++i)
+            identity.at(i, i) = 1.0f;
+
+        ftl::array<float, 4, 4> m;
+        for (std::size_t i = 0; i < m.size(); ++i)
+            m.data()[i] = static_cast<float>(i);
+
+        CHECK(ftl::matmul(identity, m) == m);
+        CHECK(ftl::matmul(m, identity) == m);
+    }
+
+    TEST_CASE("Products agree with the naive loop") {
+        SUBCASE("16x16") {
+            auto a = pseudo_random<16, 16>(1);
+            auto b = pseudo_random<16, 16>(2);
+            CHECK(ftl::matmul(a, b) == naive_matmul(a, b));
+        }
+
+        SUBCASE("Wider than one accumulator block") {
+            auto a = pseudo_random<5, 9>(3);
+            auto b = pseudo_random<9, 150>(4);
+            CHECK(ftl::matmul(a, b) == naive_matmul(a, b));
+        }
+
+        SUBCASE("Operands in other layouts") {
+            auto a = pseudo_random<8, 8>(5);
+            auto b = pseudo_random<8, 8>(6);
+            ftl::basic_array<double, ftl::column_major, 8, 8> b_columns;
+            for (std::size_t i = 0; i < 8; ++i)
+                for (std::size_t j = 0; j < 8; ++j)
+                    b_columns.at(i, j) = b.at(i, j);
+            CHECK(ftl::matmul(a, b_columns) == naive_matmul(a, b));
+        }
+    }
+
+    TEST_CASE("Transpose") {
+        SUBCASE("Small") {
+            ftl::array<int, 2, 3> a { 1, 2, 3, 4, 5, 6 };
+            auto t = ftl::transpose(a);
+            CHECK(std::is_same_v<decltype(t), ftl::array<int, 3, 2>>);
+            CHECK(t == ftl::array<int, 3, 2> { 1, 4, 2, 5, 3, 6 });
+            CHECK(ftl::transpose(t) == a);
+        }
+
+        SUBCASE("Large, split into tiles") {
+            auto a = pseudo_random<100, 70>(7);
+            auto t = ftl::transpose(a);
+            bool same = true;
+            for (std::size_t i = 0; i < 100; ++i)
+                for (std::size_t j = 0; j < 70; ++j)
+                    same = same && t.at(j, i) == a.at(i, j);
+            CHECK(same);
+        }
+    }
+
+    TEST_CASE("Usable in constant expressions") {
+        constexpr ftl::array<int, 2, 2> a { 1, 2, 3, 4 };
+        static_assert(ftl::matmul(a, a) == ftl::array<int, 2, 2> { 7, 10, 15, 22 });
+        static_assert(ftl::transpose(a) == ftl::array<int, 2, 2> { 1, 3, 2, 4 });
+        CHECK(ftl::transpose(a).at(0, 1) == 3);
+    }
+}
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
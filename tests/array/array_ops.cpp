@@ -0,0 +1,206 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <type_traits>
+#include <ftl/array_ops.hpp>
+
+namespace {
+    constexpr ftl::array<int, 4> constexpr_sum() {
+        ftl::array<int, 4> a { 1, 2, 3, 4 };
+        ftl::array<int, 4> b { 10, 20, 30, 40 };
+        ftl::array<int, 4> c = a + b * 2 - 1;
+        c += a;
+        return c;
+    }
+}
+
+TEST_SUITE("ftl::array element-wise operations") {
+    TEST_CASE("Expressions are lazy") {
+        ftl::array<float, 4> a { 1.0f, 2.0f, 3.0f, 4.0f };
+        ftl::array<float, 4> b { 4.0f, 3.0f, 2.0f, 1.0f };
+
+        auto expr = a + b;
+        CHECK(ftl::array_expression<decltype(expr)>);
+        CHECK(std::is_same_v<decltype(expr)::value_type, float>);
+
+        // operands that are lvalues are referred to, not copied
+        a = ftl::array<float, 4> { 0.0f, 0.0f, 0.0f, 0.0f };
+        ftl::array<float, 4> c = expr;
+        CHECK(c == b);
+    }
+
+    TEST_CASE("Arithmetic") {
+        ftl::array<float, 2, 2> a { 1.0f, 2.0f, 3.0f, 4.0f };
+        ftl::array<float, 2, 2> b { 2.0f, 2.0f, 2.0f, 2.0f };
+
+        SUBCASE("Binary operators") {
+            CHECK(ftl::eval(a + b) == ftl::array<float, 2, 2> { 3.0f, 4.0f, 5.0f, 6.0f });
+            CHECK(ftl::eval(a - b) == ftl::array<float, 2, 2> { -1.0f, 0.0f, 1.0f, 2.0f });
+            CHECK(ftl::eval(a * b) == ftl::array<float, 2, 2> { 2.0f, 4.0f, 6.0f, 8.0f });
+            CHECK(ftl::eval(a / b) == ftl::array<float, 2, 2> { 0.5f, 1.0f, 1.5f, 2.0f });
+            CHECK(ftl::eval(-a) == ftl::array<float, 2, 2> { -1.0f, -2.0f, -3.0f, -4.0f });
+        }
+
+        SUBCASE("Scalars are broadcast in the element type") {
+            auto scaled = ftl::eval(a * 0.5);
+            CHECK(std::is_same_v<decltype(scaled), ftl::array<float, 2, 2>>);
+            CHECK(scaled == ftl::array<float, 2, 2> { 0.5f, 1.0f, 1.5f, 2.0f });
+            CHECK(ftl::eval(10 - a) == ftl::array<float, 2, 2> { 9.0f, 8.0f, 7.0f, 6.0f });
+        }
+
+        SUBCASE("Scalars are not narrowed to integer elements") {
+            ftl::array<int, 4> n { 1, 2, 3, 4 };
+
+            auto halves = ftl::eval(n * 0.5);
+            CHECK(std::is_same_v<decltype(halves), ftl::array<double, 4>>);
+            CHECK(halves == ftl::array<double, 4> { 0.5, 1.0, 1.5, 2.0 });
+            CHECK(ftl::eval(n / 0.5) == ftl::array<double, 4> { 2.0, 4.0, 6.0, 8.0 });
+            CHECK(ftl::eval(n < 2.5) == ftl::array<bool, 4> { true, true, false, false });
+            CHECK(ftl::eval(n * 2) == ftl::array<int, 4> { 2, 4, 6, 8 });
+
+            ftl::array<int, 4> scaled = n * 1.5;
+            CHECK(scaled == ftl::array<int, 4> { 1, 3, 4, 6 });
+        }
+
+        SUBCASE("Nested expressions and temporaries") {
+            ftl::array<float, 2, 2> c = (a + b) * (a - b) + ftl::array<float, 2, 2> { 1.0f, 1.0f, 1.0f, 1.0f };
+            CHECK(c == ftl::array<float, 2, 2> { -2.0f, 1.0f, 6.0f, 13.0f });
+            CHECK(c[1][1] == 13.0f);
+        }
+
+        SUBCASE("Fused multiply-add") {
+            ftl::array<float, 2, 2> c = ftl::fma(a, b, 1.0f);
+            CHECK(c == ftl::array<float, 2, 2> { 3.0f, 5.0f, 7.0f, 9.0f });
+        }
+
+        SUBCASE("Compound assignment may read the target") {
+            a += a;
+            CHECK(a == ftl::array<float, 2, 2> { 2.0f, 4.0f, 6.0f, 8.0f });
+            a -= b;
+            a *= 2.0f;
+            a /= b;
+            CHECK(a == ftl::array<float, 2, 2> { 0.0f, 2.0f, 4.0f, 6.0f });
+            a = a * a;
+            CHECK(a == ftl::array<float, 2, 2> { 0.0f, 4.0f, 16.0f, 36.0f });
+        }
+    }
+
+    TEST_CASE("Comparisons produce masks") {
+        ftl::array<int, 4> a { 1, 5, 3, 7 };
+        ftl::array<int, 4> b { 2, 5, 1, 8 };
+
+        CHECK(ftl::eval(a < b) == ftl::array<bool, 4> { true, false, false, true });
+        CHECK(ftl::eval(a <= b) == ftl::array<bool, 4> { true, true, false, true });
+        CHECK(ftl::eval(a > 4) == ftl::array<bool, 4> { false, true, false, true });
+        CHECK(ftl::eval(a >= b) == ftl::array<bool, 4> { false, true, true, false });
+        CHECK(ftl::eval(ftl::equal(a, b)) == ftl::array<bool, 4> { false, true, false, false });
+        CHECK(ftl::eval(ftl::not_equal(a, 5)) == ftl::array<bool, 4> { true, false, true, true });
+
+        // clamp to b where a is larger
+        ftl::array<int, 4> c = ftl::select(a > b, b, a);
+        CHECK(c == ftl::array<int, 4> { 1, 5, 1, 7 });
+        CHECK(ftl::eval(ftl::select(a < 4, 0, a)) == ftl::array<int, 4> { 0, 5, 0, 7 });
+    }
+
+    TEST_CASE("Usable in constant expressions") {
+        constexpr ftl::array<int, 4> c = constexpr_sum();
+        static_assert(c == ftl::array<int, 4> { 21, 43, 65, 87 });
+        CHECK(c[3] == 87);
+    }
+    TEST_CASE("Reductions") {
+        ftl::array<int, 3, 3> m { 4, -2, 7, 0, 9, 1, 9, -5, 3 };
+
+        CHECK(ftl::sum(m) == 26);
+        CHECK(ftl::min_value(m) == -5);
+        CHECK(ftl::max_value(m) == 9);
+        CHECK(ftl::min_element(m) == 7);
+        CHECK(ftl::max_element(m) == 4); // first of the two nines
+        CHECK(ftl::dot(m, m) == 266);
+        CHECK(ftl::squared_norm(m) == 266);
+        CHECK(ftl::norm2(ftl::array<int, 2> { 3, 4 }) == 5.0);
+
+        CHECK(ftl::any(m > 8));
+        CHECK(not ftl::any(m > 9));
+        CHECK(ftl::all(m > -6));
+        CHECK(not ftl::all(m >= 0));
+
+        // expressions are reduced without a temporary array
+        CHECK(ftl::sum(m * 2 + 1) == 61);
+        CHECK(ftl::max_value(-m) == 5);
+    }
+
+    TEST_CASE("Reductions of sizes around the lane count") {
+        ftl::array<float, 1> one { 2.0f };
+        ftl::array<float, 13> odd;
+        for (int i = 0; i < 13; ++i)
+            odd[i] = static_cast<float>(i + 1);
+
+        CHECK(ftl::sum(one) == 2.0f);
+        CHECK(ftl::min_value(one) == 2.0f);
+        CHECK(ftl::sum(odd) == 91.0f);
+        CHECK(ftl::sum<ftl::multi_accumulator<3>>(odd) == 91.0f);
+        CHECK(ftl::sum<ftl::kahan_summation>(odd) == 91.0f);
+        CHECK(ftl::sum<ftl::pairwise_summation<2>>(odd) == 91.0f);
+        CHECK(ftl::max_value(odd) == 13.0f);
+        CHECK(ftl::norm2(one) == 2.0f);
+    }
+
+    TEST_CASE("Reductions of small integer types are promoted") {
+        ftl::array<uint8_t, 300> bytes;
+        bytes.fill(1);
+        CHECK(ftl::sum(bytes) == 300);
+        CHECK(ftl::sum<ftl::pairwise_summation<2>>(bytes) == 300);
+        CHECK(ftl::sum(bytes) == ftl::dot(bytes, bytes));
+
+        ftl::array<bool, 4> flags { true, true, true, true };
+        CHECK(ftl::sum(flags) == 4);
+    }
+
+    TEST_CASE("Compensated summation keeps small terms") {
+        // one large value followed by many that are each below its precision
+        ftl::array<float, 4097> values;
+        values[0] = 1.0e8f;
+        for (std::size_t i = 1; i < values.size(); ++i)
+            values[i] = 1.0f;
+
+        const double exact = 1.0e8 + 4096.0;
+        const double kahan = ftl::sum<ftl::kahan_summation>(values);
+        const double pairwise = ftl::sum<ftl::pairwise_summation<>>(values);
+        const double plain = ftl::sum<ftl::multi_accumulator<1>>(values);
+
+        CHECK(kahan == doctest::Approx(exact).epsilon(1e-7));
+        CHECK(plain == 1.0e8);
+        // only the ones summed into the block of the large value are lost
+        CHECK(exact - pairwise <= 32.0);
+    }
+
+    TEST_CASE("Reductions are usable in constant expressions") {
+        constexpr ftl::array<int, 5> a { 3, 1, 4, 1, 5 };
+        static_assert(ftl::sum(a) == 14);
+        static_assert(ftl::sum<ftl::kahan_summation>(a) == 14);
+        static_assert(ftl::sum<ftl::pairwise_summation<2>>(a) == 14);
+        static_assert(ftl::dot(a, a) == 52);
+        static_assert(ftl::min_element(a) == 1);
+        static_assert(ftl::max_value(a) == 5);
+        static_assert(ftl::all(a > 0) && not ftl::any(a > 5));
+        CHECK(ftl::sum(a) == 14);
+    }
+}
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
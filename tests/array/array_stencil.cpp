@@ -0,0 +1,155 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <type_traits>
+#include <ftl/array_stencil.hpp>
+
+namespace {
+    template <std::size_t R, std::size_t C>
+    constexpr ftl::array<int, R, C> numbered() {
+        ftl::array<int, R, C> grid;
+        for (std::size_t i = 0; i < grid.size(); ++i)
+            grid.data()[i] = static_cast<int>(i);
+        return grid;
+    }
+
+    // Sum of the 3x3 neighbourhood of every element
+    template <typename Policy, std::size_t R, std::size_t C>
+    constexpr ftl::array<int, R, C> box_sum(const ftl::array<int, R, C>& grid, const Policy& policy) {
+        ftl::array<int, R, C> result(0);
+        result.fill(-1);
+        ftl::for_each_stencil<1>(grid, policy, [&](const auto& n, std::size_t r, std::size_t c) {
+            int total = 0;
+            for (int dr = -1; dr <= 1; ++dr)
+                for (int dc = -1; dc <= 1; ++dc)
+                    total += n.at(dr, dc);
+            result.at(r, c) = total;
+        });
+        return result;
+    }
+
+    std::size_t clamped(std::ptrdiff_t i, std::size_t extent) {
+        return i < 0 ? 0 : i >= static_cast<std::ptrdiff_t>(extent) ? extent - 1 : static_cast<std::size_t>(i);
+    }
+}
+
+TEST_SUITE("ftl::array stencils") {
+    TEST_CASE("Clamp boundary") {
+        constexpr std::size_t R = 5;
+        constexpr std::size_t C = 7;
+        auto grid = numbered<R, C>();
+        auto result = box_sum(grid, ftl::clamp_boundary{});
+
+        for (std::size_t r = 0; r < R; ++r) {
+            for (std::size_t c = 0; c < C; ++c) {
+                int expected = 0;
+                for (int dr = -1; dr <= 1; ++dr)
+                    for (int dc = -1; dc <= 1; ++dc)
+                        expected += grid.at(clamped(static_cast<std::ptrdiff_t>(r) + dr, R),
+                                            clamped(static_cast<std::ptrdiff_t>(c) + dc, C));
+                CHECK(result.at(r, c) == expected);
+            }
+        }
+    }
+
+    TEST_CASE("Wrap boundary") {
+        auto grid = numbered<4, 4>();
+        auto result = box_sum(grid, ftl::wrap_boundary{});
+
+        // 15, 12, 13 / 3, 0, 1 / 7, 4, 5
+        CHECK(result.at(0, 0) == 15 + 12 + 13 + 3 + 0 + 1 + 7 + 4 + 5);
+        CHECK(result.at(1, 1) == 0 + 1 + 2 + 4 + 5 + 6 + 8 + 9 + 10);
+
+        // every element is read nine times
+        int total = 0;
+        for (int value : result)
+            total += value;
+        CHECK(total == 9 * (15 * 16 / 2));
+    }
+
+    TEST_CASE("Constant boundary") {
+        ftl::array<int, 3, 3> ones;
+        ones.fill(1);
+
+        auto result = box_sum(ones, ftl::constant_boundary<int>{ 0 });
+        CHECK(result.at(0, 0) == 4);
+        CHECK(result.at(0, 1) == 6);
+        CHECK(result.at(1, 1) == 9);
+        CHECK(result.at(2, 2) == 4);
+
+        auto padded = box_sum(ones, ftl::constant_boundary<int>{ 10 });
+        CHECK(padded.at(0, 0) == 4 + 5 * 10);
+        CHECK(padded.at(1, 1) == 9);
+    }
+
+    TEST_CASE("Skip boundary") {
+        auto grid = numbered<5, 6>();
+        auto result = box_sum(grid, ftl::skip_boundary{});
+
+        std::size_t visited = 0;
+        for (int value : result)
+            visited += value != -1;
+        CHECK(visited == 3 * 4);
+
+        CHECK(result.at(0, 3) == -1);
+        CHECK(result.at(4, 5) == -1);
+        CHECK(result.at(1, 1) == 9 * grid.at(1, 1));
+        CHECK(result.at(3, 4) == 9 * grid.at(3, 4));
+
+        // nothing is far enough from the edges
+        auto narrow = box_sum(numbered<2, 8>(), ftl::skip_boundary{});
+        for (int value : narrow)
+            CHECK(value == -1);
+    }
+
+    TEST_CASE("Three dimensions and larger radius") {
+        ftl::array<int, 4, 5, 6> cube;
+        cube.fill(1);
+
+        std::size_t calls = 0;
+        bool all_indices_match = true;
+        ftl::for_each_stencil<2>(cube, ftl::constant_boundary<int>{ 0 }, [&](const auto& n, std::size_t i, std::size_t j, std::size_t k) {
+            ++calls;
+            all_indices_match = all_indices_match && n.index(0) == i && n.index(1) == j && n.index(2) == k;
+
+            int total = 0;
+            for (int di = -2; di <= 2; ++di)
+                for (int dj = -2; dj <= 2; ++dj)
+                    for (int dk = -2; dk <= 2; ++dk)
+                        total += n.at(di, dj, dk);
+
+            if (i == 2 && j == 2 && k == 2)
+                CHECK(total == 4 * 5 * 5);
+            if (i == 0 && j == 0 && k == 0)
+                CHECK(total == 3 * 3 * 3);
+            CHECK(n.centre() == 1);
+        });
+        CHECK(calls == cube.size());
+        CHECK(all_indices_match);
+    }
+
+    TEST_CASE("Stencils in constant expressions") {
+        constexpr auto result = box_sum(numbered<3, 3>(), ftl::clamp_boundary{});
+        static_assert(result.at(1, 1) == 36);
+        static_assert(result.at(0, 0) == 0 + 0 + 1 + 0 + 0 + 1 + 3 + 3 + 4);
+        CHECK(result.at(2, 2) == 8 * 4 + 7 * 2 + 5 * 2 + 4);
+    }
+}
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
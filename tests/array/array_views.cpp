@@ -0,0 +1,163 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <type_traits>
+#include <ftl/array.hpp>
+#include <ftl/array_layout.hpp>
+
+namespace {
+    // 0, 1, 2, ... in storage order
+    template <std::size_t R, std::size_t C>
+    constexpr ftl::array<int, R, C> iota_grid() {
+        ftl::array<int, R, C> grid;
+        for (std::size_t i = 0; i < grid.size(); ++i)
+            grid.data()[i] = static_cast<int>(i);
+        return grid;
+    }
+}
+
+TEST_SUITE("ftl::array views") {
+    TEST_CASE("Rows and columns") {
+        auto grid = iota_grid<3, 4>();
+
+        auto row = grid.row(1);
+        CHECK(row.size() == 4);
+        CHECK(row[0] == 4);
+        CHECK(row[3] == 7);
+
+        auto col = grid.col(2);
+        CHECK(col.size() == 3);
+        CHECK(col.stride(0) == 4);
+        CHECK(col[0] == 2);
+        CHECK(col[2] == 10);
+
+        int sum = 0;
+        for (int value : col)
+            sum += value;
+        CHECK(sum == 2 + 6 + 10);
+
+        // views refer to the array
+        col.fill(-1);
+        CHECK(grid.at(0, 2) == -1);
+        CHECK(grid.at(2, 2) == -1);
+        CHECK(grid.at(2, 3) == 11);
+
+        const auto& cgrid = grid;
+        CHECK(std::is_same_v<decltype(cgrid.row(0)[0]), const int&>);
+    }
+
+    TEST_CASE("Blocks") {
+        auto grid = iota_grid<4, 5>();
+        auto block = grid.block<2, 3>(1, 2);
+
+        CHECK(block.size() == 6);
+        CHECK(block.extent(0) == 2);
+        CHECK(block.extent(1) == 3);
+        CHECK(block[0][0] == 7);
+        CHECK(block[1][2] == 14);
+        CHECK(block.at(1, 0) == 12);
+
+        SUBCASE("Iteration is row-major over the block") {
+            int expected[] = { 7, 8, 9, 12, 13, 14 };
+            int n = 0;
+            for (int value : block)
+                CHECK(value == expected[n++]);
+            CHECK(n == 6);
+        }
+
+        SUBCASE("Copying out and in") {
+            ftl::array<int, 2, 3> copy = block.to_array();
+            CHECK(copy.at(0, 0) == 7);
+            CHECK(copy.at(1, 2) == 14);
+
+            grid.block<2, 3>(0, 0).copy_from(copy);
+            CHECK(grid.at(0, 0) == 7);
+            CHECK(grid.at(1, 2) == 14);
+            CHECK(grid.at(1, 3) == 8);
+
+            // between views
+            grid.row(3).copy_from(grid.row(2));
+            CHECK(grid.at(3, 4) == 14);
+        }
+    }
+
+    TEST_CASE("Copying from other layouts") {
+        ftl::basic_array<int, ftl::column_major, 2, 2> columns;
+        columns.at(0, 0) = 1;
+        columns.at(0, 1) = 2;
+        columns.at(1, 0) = 3;
+        columns.at(1, 1) = 4;
+
+        auto grid = iota_grid<4, 4>();
+        grid.block<2, 2>(1, 1).copy_from(columns);
+        CHECK(grid.at(1, 1) == 1);
+        CHECK(grid.at(1, 2) == 2);
+        CHECK(grid.at(2, 1) == 3);
+        CHECK(grid.at(2, 2) == 4);
+
+        ftl::basic_array<int, ftl::morton, 4, 4> z_order;
+        for (std::size_t i = 0; i < 4; ++i)
+            for (std::size_t j = 0; j < 4; ++j)
+                z_order.at(i, j) = static_cast<int>(i * 4 + j);
+
+        auto target = iota_grid<4, 4>();
+        target.fill(0);
+        target.view().copy_from(z_order);
+        CHECK(target == iota_grid<4, 4>());
+    }
+
+    TEST_CASE("Strided slices") {
+        auto grid = iota_grid<6, 6>();
+
+        auto every_other = grid.slice<ftl::extents<3, 3>, ftl::extents<2, 2>>(0, 1);
+        CHECK(every_other.stride(0) == 12);
+        CHECK(every_other.stride(1) == 2);
+        CHECK(every_other.at(0, 0) == 1);
+        CHECK(every_other.at(1, 1) == 15);
+        CHECK(every_other.at(2, 2) == 29);
+
+        int sum = 0;
+        every_other.for_each([&sum](int value) { sum += value; });
+        CHECK(sum == 1 + 3 + 5 + 13 + 15 + 17 + 25 + 27 + 29);
+    }
+
+    TEST_CASE("Views of three-dimensional arrays") {
+        ftl::array<int, 2, 3, 4> cube;
+        for (std::size_t i = 0; i < cube.size(); ++i)
+            cube.data()[i] = static_cast<int>(i);
+
+        auto full = cube.view();
+        CHECK(full.stride(0) == 12);
+        CHECK(full.stride(1) == 4);
+        CHECK(full[1][2][3] == 23);
+
+        auto block = cube.block<1, 2, 2>(1, 1, 2);
+        CHECK(block.at(0, 0, 0) == 18);
+        CHECK(block.at(0, 1, 1) == 23);
+    }
+
+    TEST_CASE("Views in constant expressions") {
+        constexpr auto grid = iota_grid<3, 3>();
+        static_assert(grid.col(1)[2] == 7);
+        static_assert(grid.block<2, 2>(1, 1).to_array().at(1, 1) == 8);
+        CHECK(grid.row(2)[0] == 6);
+    }
+}
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
@@ -0,0 +1,95 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <ftl/array_parallel.hpp>
+
+TEST_SUITE("ftl::parallel array algorithms") {
+    TEST_CASE("transform") {
+        ftl::thread_pool pool(4);
+        auto input = std::make_unique<ftl::array<double, 300, 301>>();
+        auto output = std::make_unique<ftl::array<float, 300, 301>>();
+
+        for (std::size_t i = 0; i < input->size(); ++i)
+            input->data()[i] = static_cast<double>(i);
+
+        ftl::parallel::transform(pool, *input, *output, [](double x) { return static_cast<float>(x * 0.5); });
+
+        bool all_match = true;
+        for (std::size_t i = 0; i < output->size(); ++i)
+            all_match = all_match && output->data()[i] == static_cast<float>(static_cast<double>(i) * 0.5);
+        CHECK(all_match);
+    }
+
+    TEST_CASE("for_each_index") {
+        ftl::thread_pool pool(4);
+        auto grid = std::make_unique<ftl::array<std::uint32_t, 40, 50, 60>>();
+
+        ftl::parallel::for_each_index(pool, *grid, [](std::uint32_t& element, std::size_t i, std::size_t j, std::size_t k) {
+            element = static_cast<std::uint32_t>(i * 10000 + j * 100 + k);
+        });
+
+        CHECK(grid->at(0, 0, 0) == 0);
+        CHECK(grid->at(39, 49, 59) == 394959);
+        CHECK(grid->at(12, 3, 45) == 120345);
+
+        std::atomic<std::size_t> visited = 0;
+        std::atomic<std::size_t> mismatched = 0;
+        const auto& cgrid = *grid;
+        ftl::parallel::for_each_index(pool, cgrid, [&](const std::uint32_t& element, std::size_t i, std::size_t j, std::size_t k) {
+            visited.fetch_add(1, std::memory_order_relaxed);
+            if (element != i * 10000 + j * 100 + k)
+                mismatched.fetch_add(1, std::memory_order_relaxed);
+        });
+        CHECK(visited.load() == grid->size());
+        CHECK(mismatched.load() == 0);
+
+        ftl::basic_array<int, ftl::column_major, 70, 80> columns;
+        ftl::parallel::for_each_index(pool, columns, [](int& element, std::size_t r, std::size_t c) {
+            element = static_cast<int>(r * 80 + c);
+        });
+        CHECK(columns.at(69, 79) == 69 * 80 + 79);
+        CHECK(columns.data()[1] == 80);
+    }
+
+    TEST_CASE("reduce") {
+        auto values = std::make_unique<ftl::array<double, 200, 250>>();
+        for (std::size_t i = 0; i < values->size(); ++i)
+            values->data()[i] = 1.0 / static_cast<double>(i + 1);
+
+        auto plus = [](double a, double b) { return a + b; };
+
+        ftl::thread_pool pool_a(2);
+        ftl::thread_pool pool_b(5);
+        const double a = ftl::parallel::reduce(pool_a, *values, 0.0, plus);
+        const double b = ftl::parallel::reduce(pool_b, *values, 0.0, plus);
+        const double c = ftl::parallel::reduce(pool_b, *values, 0.0, plus);
+
+        // same bits whatever the threads
+        CHECK(a == b);
+        CHECK(b == c);
+
+        const double unordered = ftl::parallel::reduce(pool_b, *values, 0.0, plus, ftl::parallel::reduction_order::unordered);
+        CHECK(unordered == doctest::Approx(a));
+
+        ftl::array<int, 1000> counts;
+        counts.fill(3);
+        CHECK(ftl::parallel::reduce(pool_a, counts, std::int64_t(0), [](std::int64_t x, std::int64_t y) { return x + y; }) == 3000);
+        CHECK(ftl::parallel::reduce(pool_a, counts, 0, [](int x, int y) { return x > y ? x : y; },
+                                    ftl::parallel::reduction_order::unordered) == 3);
+    }
+
+    TEST_CASE("exceptions reach the caller") {
+        ftl::thread_pool pool(3);
+        ftl::array<int, 10000> values;
+        values.fill(1);
+        values[7777] = -1;
+
+        CHECK_THROWS_AS(ftl::parallel::for_each_index(pool, values, [](int element, std::size_t) {
+            if (element < 0)
+                throw std::runtime_error("negative");
+        }), std::runtime_error);
+    }
+}
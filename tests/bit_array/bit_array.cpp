@@ -0,0 +1,127 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <type_traits>
+#include <ftl/bit_array.hpp>
+
+TEST_SUITE("ftl::bit_array") {
+    TEST_CASE("Storage") {
+        static_assert(sizeof(ftl::bit_array<1024, 1024>) == 128 * 1024);
+        static_assert(sizeof(ftl::bit_array<3, 3>) == 8);
+        static_assert(ftl::bit_array<65>::word_count == 2);
+        static_assert(std::is_trivially_copyable_v<ftl::bit_array<10, 10>>);
+
+        ftl::bit_array<10, 10> bits;
+        CHECK(bits.none());
+        CHECK(bits.count() == 0);
+        CHECK(bits.size() == 100);
+        CHECK(bits.extent(1) == 10);
+    }
+
+    TEST_CASE("Element access") {
+        ftl::bit_array<5, 7, 3> bits;
+
+        bits.at(4, 6, 2) = true;
+        bits.at(1, 2, 0) = true;
+        CHECK(bits.at(4, 6, 2));
+        CHECK(bits.at(1, 2, 0));
+        CHECK_FALSE(bits.at(1, 2, 1));
+        CHECK(bits.test(104));
+        CHECK(bits.count() == 2);
+
+        bits.at(1, 2, 1) = bits.at(1, 2, 0);
+        bits.at(1, 2, 0).flip();
+        CHECK(bits.at(1, 2, 1));
+        CHECK_FALSE(bits.at(1, 2, 0));
+
+        bits.at(4, 6, 2) = false;
+        CHECK(bits.count() == 1);
+
+        const auto& cbits = bits;
+        CHECK(cbits.at(1, 2, 1));
+
+        ftl::bit_array<70> line;
+        line[69] = true;
+        CHECK(line[69]);
+        CHECK(~line[68]);
+        CHECK(line.data()[1] == (uint64_t(1) << 5));
+    }
+
+    TEST_CASE("Whole array operations") {
+        ftl::bit_array<10, 10> a;
+        ftl::bit_array<10, 10> b;
+
+        a.set();
+        CHECK(a.all());
+        CHECK(a.count() == 100);
+
+        // bits past the end stay clear
+        CHECK(a.data()[1] == (uint64_t(1) << 36) - 1);
+
+        for (std::size_t i = 0; i < 10; ++i)
+            b.at(i, i) = true;
+
+        CHECK((a & b) == b);
+        CHECK((a ^ b).count() == 90);
+        CHECK((~b).count() == 90);
+        CHECK((~b | b) == a);
+        CHECK((b ^ b).none());
+
+        a.flip();
+        CHECK(a.none());
+        a |= b;
+        CHECK(a == b);
+        a.reset();
+        CHECK(a.none());
+    }
+
+    TEST_CASE("Finding set bits") {
+        ftl::bit_array<20, 20> grid;
+        CHECK(grid.find_first() == grid.npos);
+
+        const std::size_t positions[] = { 3, 63, 64, 65, 200, 399 };
+        for (std::size_t p : positions)
+            grid.at(p / 20, p % 20) = true;
+
+        std::size_t found = 0;
+        for (std::size_t p = grid.find_first(); p != grid.npos; p = grid.find_next(p))
+            CHECK(p == positions[found++]);
+        CHECK(found == 6);
+
+        CHECK(grid.find_next(399) == grid.npos);
+        CHECK(grid.find_next(65) == 200);
+        CHECK(grid.find_next(0) == 3);
+    }
+
+    TEST_CASE("Constant expressions") {
+        constexpr auto bits = [] {
+            ftl::bit_array<8, 8> result;
+            for (std::size_t i = 0; i < 8; ++i)
+                result.at(i, 7 - i) = true;
+            return result;
+        }();
+
+        static_assert(bits.count() == 8);
+        static_assert(bits.find_first() == 7);
+        static_assert(bits.at(7, 0));
+        CHECK(bits.find_next(7) == 14);
+    }
+}
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
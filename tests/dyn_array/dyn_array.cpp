@@ -0,0 +1,245 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <type_traits>
+#include <string>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <ftl/dyn_array.hpp>
+
+namespace {
+    // Throws from the constructor that would make more than limit alive
+    struct limited
+    {
+        static inline int alive = 0;
+        static inline int limit = 0;
+
+        limited() { make(); }
+        limited(const limited&) { make(); }
+        ~limited() { --alive; }
+
+        void make() {
+            if (alive == limit)
+                throw std::runtime_error("limit reached");
+            ++alive;
+        }
+    };
+
+    template <typename T>
+    struct counting_allocator
+    {
+        using value_type = T;
+
+        static inline int outstanding = 0;
+
+        T* allocate(std::size_t n) {
+            ++outstanding;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) {
+            --outstanding;
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        bool operator==(const counting_allocator&) const = default;
+    };
+}
+
+TEST_SUITE("ftl::dyn_array") {
+    TEST_CASE("static requirements") {
+        SUBCASE("allocated dyn_array is nothrow movable and copyable") {
+            CHECK(std::is_nothrow_default_constructible<ftl::dyn_array<int, 2>>::value);
+            CHECK(std::is_nothrow_move_constructible<ftl::dyn_array<int, 2>>::value);
+            CHECK(std::is_nothrow_move_assignable<ftl::dyn_array<int, 2>>::value);
+            CHECK(std::is_copy_constructible<ftl::dyn_array<std::string, 2>>::value);
+            CHECK(std::is_copy_assignable<ftl::dyn_array<std::string, 2>>::value);
+        }
+
+        SUBCASE("extents are not implicit conversions") {
+            CHECK_FALSE(std::is_convertible<int, ftl::dyn_array<int, 1>>::value);
+            CHECK(std::is_constructible<ftl::dyn_array<int, 3>, int, int, int>::value);
+            CHECK_FALSE(std::is_constructible<ftl::dyn_array<int, 3>, int, int>::value);
+        }
+    }
+
+    TEST_CASE("Construction and extents") {
+        ftl::dyn_array<int, 3> arr(2, 3, 4);
+
+        CHECK(arr.size() == 24);
+        CHECK(arr.extent(0) == 2);
+        CHECK(arr.extent(1) == 3);
+        CHECK(arr.extent(2) == 4);
+        CHECK_FALSE(arr.empty());
+
+        for (int value : arr)
+            CHECK(value == 0);
+
+        ftl::dyn_array<int, 2> empty;
+        CHECK(empty.empty());
+        CHECK(empty.size() == 0);
+        CHECK(empty.begin() == empty.end());
+    }
+
+    TEST_CASE("Element access is row-major") {
+        ftl::dyn_array<int, 3> arr(2, 3, 4);
+
+        for (std::size_t i = 0; i < 2; ++i)
+            for (std::size_t j = 0; j < 3; ++j)
+                for (std::size_t k = 0; k < 4; ++k)
+                    arr.at(i, j, k) = static_cast<int>(i * 100 + j * 10 + k);
+
+        CHECK(arr.data()[0] == 0);
+        CHECK(arr.data()[1] == 1);
+        CHECK(arr.data()[4] == 10);
+        CHECK(arr.data()[12] == 100);
+        CHECK(arr.back() == 123);
+
+        const auto& carr = arr;
+        CHECK(carr.at(1, 2, 3) == 123);
+        CHECK(carr.at(0, 1, 2) == 12);
+
+        ftl::dyn_array<float, 1> line(5);
+        line[3] = 2.5f;
+        CHECK(line.at(3) == 2.5f);
+        CHECK(line[3] == 2.5f);
+    }
+
+    TEST_CASE("Copy, move and comparison") {
+        ftl::dyn_array<std::string, 2> arr(2, 2);
+        arr.at(0, 0) = "top left";
+        arr.at(1, 1) = "bottom right";
+
+        ftl::dyn_array<std::string, 2> copy = arr;
+        CHECK(copy == arr);
+        CHECK(copy.data() != arr.data());
+
+        copy.at(0, 1) = "changed";
+        CHECK_FALSE(copy == arr);
+
+        const std::string* old_data = copy.data();
+        ftl::dyn_array<std::string, 2> moved = std::move(copy);
+        CHECK(moved.data() == old_data);
+        CHECK(moved.at(0, 1) == "changed");
+        CHECK(copy.empty());
+        CHECK(copy.extent(0) == 0);
+
+        moved = arr;
+        CHECK(moved == arr);
+
+        arr = std::move(moved);
+        CHECK(arr.at(1, 1) == "bottom right");
+        CHECK(moved.empty());
+
+        // same elements, different shape
+        ftl::dyn_array<int, 2> wide(1, 4);
+        ftl::dyn_array<int, 2> tall(4, 1);
+        CHECK_FALSE(wide == tall);
+    }
+
+    TEST_CASE("Resize and fill") {
+        ftl::dyn_array<int, 2> arr(3, 3);
+        arr.fill(7);
+        for (int value : arr)
+            CHECK(value == 7);
+
+        const int* old_data = arr.data();
+        arr.resize(1, 9);
+        CHECK(arr.data() == old_data);
+        CHECK(arr.extent(0) == 1);
+        CHECK(arr.extent(1) == 9);
+        CHECK(arr.at(0, 8) == 0);
+
+        arr.resize(4, 5);
+        CHECK(arr.size() == 20);
+        CHECK(arr.at(3, 4) == 0);
+
+        arr.clear();
+        CHECK(arr.empty());
+    }
+
+    TEST_CASE("Aligned allocation") {
+        ftl::dyn_array<float, 2, ftl::aligned_allocator<float, 64>> arr(3, 5);
+        CHECK(reinterpret_cast<std::uintptr_t>(arr.data()) % 64 == 0);
+
+        arr.at(2, 4) = 1.0f;
+        auto copy = arr;
+        CHECK(reinterpret_cast<std::uintptr_t>(copy.data()) % 64 == 0);
+        CHECK(copy.at(2, 4) == 1.0f);
+
+        ftl::dyn_array<float, 2, ftl::aligned_allocator<float, 64>> with_allocator(arr.get_allocator(), 2, 2);
+        CHECK(with_allocator.size() == 4);
+    }
+
+    TEST_CASE("Static storage") {
+        using static_array = ftl::dyn_array<std::string, 2, ftl::static_storage<16, 32>>;
+        CHECK(sizeof(static_array) >= 16 * sizeof(std::string));
+
+        static_array arr(3, 4);
+        CHECK(reinterpret_cast<std::uintptr_t>(arr.data()) % 32 == 0);
+        arr.at(2, 3) = "last";
+
+        static_array moved = std::move(arr);
+        CHECK(moved.at(2, 3) == "last");
+        CHECK(arr.empty());
+
+        static_array copy = moved;
+        CHECK(copy == moved);
+
+        CHECK_THROWS_AS(copy.resize(5, 5), std::length_error);
+    }
+
+    TEST_CASE("Throwing element constructors") {
+        using limited_array = ftl::dyn_array<limited, 2, counting_allocator<limited>>;
+        limited::limit = 10;
+
+        CHECK_THROWS_AS(limited_array(4, 4), std::runtime_error);
+        CHECK(limited::alive == 0);
+        CHECK(counting_allocator<limited>::outstanding == 0);
+
+        limited_array arr(2, 3);
+        CHECK(limited::alive == 6);
+        CHECK_THROWS_AS(limited_array { arr }, std::runtime_error);
+        CHECK(limited::alive == 6);
+        CHECK(counting_allocator<limited>::outstanding == 1);
+
+        CHECK_THROWS_AS(arr.resize(3, 4), std::runtime_error);
+        CHECK(arr.empty());
+        CHECK(limited::alive == 0);
+        CHECK(counting_allocator<limited>::outstanding == 0);
+
+        arr.resize(2, 5);
+        CHECK(limited::alive == 10);
+    }
+
+    TEST_CASE("Throwing element moves in static storage") {
+        using static_limited = ftl::dyn_array<limited, 1, ftl::static_storage<8>>;
+        limited::alive = 0;
+        limited::limit = 7;
+
+        {
+            static_limited a(5);
+            static_limited b;
+            CHECK_THROWS_AS(b = std::move(a), std::runtime_error);
+            CHECK(b.empty());
+            CHECK(a.size() == 5);
+            CHECK(limited::alive == 5);
+
+            CHECK_THROWS_AS(static_limited { std::move(a) }, std::runtime_error);
+            CHECK(limited::alive == 5);
+
+            // the copy is made and then moved, either may throw
+            static_limited c(1);
+            CHECK_THROWS_AS(c = a, std::runtime_error);
+            CHECK(c.size() == 1);
+            CHECK(limited::alive == 6);
+
+            limited::limit = 11;
+            b = std::move(a);
+            CHECK(b.size() == 5);
+            CHECK(a.empty());
+            CHECK(limited::alive == 6);
+        }
+        CHECK(limited::alive == 0);
+    }
+}
@@ -0,0 +1,103 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+#include <ftl/hash.hpp>
+#include <ftl/array.hpp>
+
+namespace {
+    std::vector<uint8_t> pattern(std::size_t size) {
+        std::vector<uint8_t> bytes(size);
+        for (std::size_t i = 0; i < size; ++i)
+            bytes[i] = static_cast<uint8_t>(i * 131 + (i >> 7));
+        return bytes;
+    }
+}
+
+TEST_SUITE("ftl::hash") {
+    TEST_CASE("hash_fast64 values do not depend on the target") {
+        // the same values with scalar, SSE2 and AVX2 code, across the
+        // short, medium and long input paths
+        struct { std::size_t size; uint64_t value; } expected[] = {
+            { 0, 0x93228a4de0eec5a2ULL },
+            { 1, 0x8e6d4af7d310c8c4ULL },
+            { 3, 0xaad0ddc3361c6686ULL },
+            { 4, 0x2f59b5b051eed376ULL },
+            { 8, 0x866b2ab8ed10564dULL },
+            { 16, 0x80bf14165ce8f933ULL },
+            { 17, 0x60380089a5060f90ULL },
+            { 48, 0x8a144b427a9ab2d6ULL },
+            { 49, 0x102fa6b802b9ce15ULL },
+            { 100, 0xcc79b8228753b8b0ULL },
+            { 256, 0xb43914c009af87a2ULL },
+            { 257, 0x029d0f7e4788ab54ULL },
+            { 1024, 0xe7be9c6ca7cdbe20ULL },
+            { 1025, 0xeccbe8d819d8556eULL },
+            { 5000, 0x14639b86d963a159ULL },
+        };
+
+        const auto bytes = pattern(5000);
+        for (const auto& e : expected)
+            CHECK(ftl::hash_fast64::hash64(bytes.data(), e.size) == e.value);
+    }
+
+    TEST_CASE("hash_fast64 does not depend on alignment") {
+        const auto bytes = pattern(3000);
+        std::vector<uint8_t> shifted(bytes.size() + 7);
+
+        for (std::size_t offset = 1; offset < 8; ++offset) {
+            std::copy(bytes.begin(), bytes.end(), shifted.begin() + static_cast<std::ptrdiff_t>(offset));
+            for (std::size_t size : { std::size_t(5), std::size_t(40), std::size_t(200), std::size_t(3000) })
+                CHECK(ftl::hash_fast64::hash64(shifted.data() + offset, size) == ftl::hash_fast64::hash64(bytes.data(), size));
+        }
+    }
+
+    TEST_CASE("hash_fast64 separates similar inputs") {
+        SUBCASE("Every prefix length hashes differently") {
+            const auto bytes = pattern(2100);
+            std::set<uint64_t> seen;
+            for (std::size_t size = 0; size <= bytes.size(); ++size)
+                seen.insert(ftl::hash_fast64::hash64(bytes.data(), size));
+            CHECK(seen.size() == bytes.size() + 1);
+        }
+
+        SUBCASE("Every single bit flip changes the hash") {
+            for (std::size_t size : { std::size_t(3), std::size_t(16), std::size_t(100), std::size_t(1500) }) {
+                auto bytes = pattern(size);
+                const uint64_t original = ftl::hash_fast64::hash64(bytes.data(), size);
+
+                std::set<uint64_t> seen = { original };
+                for (std::size_t bit = 0; bit < size * 8; ++bit) {
+                    bytes[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+                    seen.insert(ftl::hash_fast64::hash64(bytes.data(), size));
+                    bytes[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+                }
+                CHECK(seen.size() == size * 8 + 1);
+            }
+        }
+
+        SUBCASE("Small integer keys spread over all bits") {
+            uint64_t ones = 0;
+            uint64_t zeros = 0;
+            for (uint32_t key = 0; key < 4096; ++key) {
+                const uint64_t value = ftl::hash_fast64::hash64(reinterpret_cast<const uint8_t*>(&key), sizeof(key));
+                ones |= value;
+                zeros |= ~value;
+            }
+            CHECK(ones == ~uint64_t(0));
+            CHECK(zeros == ~uint64_t(0));
+        }
+    }
+
+    TEST_CASE("Choosing the hash type") {
+        const std::string text = "the quick brown fox jumps over the lazy dog";
+        CHECK(ftl::hash<ftl::hash_fast64>(text)
+              == ftl::hash_fast64::hash64(reinterpret_cast<const uint8_t*>(text.data()), text.size()));
+        CHECK(ftl::hash(text) == ftl::hash<ftl::hash_fnv1a>(text));
+
+        ftl::array<uint32_t, 4, 4> grid(1u, 2u, 3u, 4u);
+        CHECK(ftl::hash<ftl::hash_fast64>(grid) == ftl::hash_fast64::hash64(reinterpret_cast<const uint8_t*>(grid.data()), grid.byte_size()));
+    }
+}
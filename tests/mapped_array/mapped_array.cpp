@@ -0,0 +1,92 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <ftl/mapped_array.hpp>
+#include <ftl/array_ops.hpp>
+
+namespace {
+    std::string temporary_path(const char* name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+}
+
+TEST_SUITE("ftl::mapped_array") {
+    TEST_CASE("Round trip through a file") {
+        const std::string path = temporary_path("ftl_mapped_array_test.bin");
+
+        auto table = std::make_unique<ftl::array<uint32_t, 16, 1000>>();
+        for (std::size_t i = 0; i < table->size(); ++i)
+            table->data()[i] = static_cast<uint32_t>(i * 2654435761u);
+
+        REQUIRE(ftl::write_binary(*table, path.c_str()));
+        CHECK(std::filesystem::file_size(path) == 64 + table->byte_size());
+
+        ftl::mapped_array<uint32_t, 16, 1000> mapped(path.c_str());
+        REQUIRE(mapped.is_open());
+        CHECK(mapped.error() == ftl::mapped_array_error::none);
+
+        CHECK(reinterpret_cast<std::uintptr_t>(mapped.data()) % 64 == 0);
+        CHECK(mapped.at(3, 7) == table->at(3, 7));
+        CHECK(mapped[15][999] == table->at(15, 999));
+        CHECK(mapped->row(2)[10] == table->at(2, 10));
+        CHECK(mapped.get() == *table);
+        CHECK(ftl::sum(mapped.get()) == ftl::sum(*table));
+        CHECK(mapped.size() == 16000);
+
+        ftl::mapped_array<uint32_t, 16, 1000> moved = std::move(mapped);
+        CHECK_FALSE(mapped.is_open());
+        CHECK(moved.is_open());
+        CHECK(*moved.begin() == table->data()[0]);
+
+        moved.close();
+        CHECK_FALSE(moved.is_open());
+        std::filesystem::remove(path);
+    }
+
+    TEST_CASE("Mismatched files are refused") {
+        const std::string path = temporary_path("ftl_mapped_array_mismatch.bin");
+
+        ftl::array<float, 4, 5> values;
+        values.fill(1.5f);
+        REQUIRE(ftl::write_binary(values, path.c_str()));
+
+        CHECK(ftl::mapped_array<float, 4, 5>(path.c_str()).is_open());
+        CHECK(ftl::mapped_array<double, 4, 5>(path.c_str()).error() == ftl::mapped_array_error::element_size);
+        CHECK(ftl::mapped_array<float, 5, 4>(path.c_str()).error() == ftl::mapped_array_error::extents);
+        CHECK(ftl::mapped_array<float, 20>(path.c_str()).error() == ftl::mapped_array_error::extents);
+
+        // other endianness
+        {
+            FILE* file = std::fopen(path.c_str(), "r+b");
+            REQUIRE(file != nullptr);
+            const uint32_t swapped = 0x04030201;
+            std::fseek(file, 8, SEEK_SET);
+            std::fwrite(&swapped, sizeof(swapped), 1, file);
+            std::fclose(file);
+        }
+        CHECK(ftl::mapped_array<float, 4, 5>(path.c_str()).error() == ftl::mapped_array_error::byte_order);
+
+        // truncated
+        REQUIRE(ftl::write_binary(values, path.c_str()));
+        std::filesystem::resize_file(path, 64 + 10);
+        CHECK(ftl::mapped_array<float, 4, 5>(path.c_str()).error() == ftl::mapped_array_error::bad_header);
+
+        // not written by write_binary
+        {
+            FILE* file = std::fopen(path.c_str(), "wb");
+            REQUIRE(file != nullptr);
+            std::fputs("just some text that is long enough to hold a header", file);
+            std::fclose(file);
+        }
+        CHECK(ftl::mapped_array<float, 4, 5>(path.c_str()).error() == ftl::mapped_array_error::bad_header);
+
+        std::filesystem::remove(path);
+        ftl::mapped_array<float, 4, 5> missing(path.c_str());
+        CHECK_FALSE(missing.is_open());
+        CHECK(missing.error() == ftl::mapped_array_error::open_failed);
+    }
+}
@@ -11,25 +11,29 @@ TEST_SUITE("ftl::ring buffer with allocator") {
     TEST_CASE("static requirements (builtin value)") {
         SUBCASE("ring buffer is nothrow constructible and assignable") {
             CHECK(std::is_nothrow_constructible<std_alloc_ring_buffer<int>>::value);
-            CHECK(std::is_nothrow_copy_constructible<std_alloc_ring_buffer<int>>::value);
             CHECK(std::is_nothrow_move_constructible<std_alloc_ring_buffer<int>>::value);
-            CHECK(std::is_nothrow_copy_assignable<std_alloc_ring_buffer<int>>::value);
             CHECK(std::is_nothrow_move_assignable<std_alloc_ring_buffer<int>>::value);
+
+            // copying allocates
+            CHECK(std::is_copy_constructible<std_alloc_ring_buffer<int>>::value);
+            CHECK(std::is_copy_assignable<std_alloc_ring_buffer<int>>::value);
         }
     }
 
     TEST_CASE("static requirements (trivial value)") {
         SUBCASE("ring buffer is nothrow constructible and assignable") {
             CHECK(std::is_nothrow_constructible<std_alloc_ring_buffer<ftl_test::trivial_type>>::value);
-            CHECK(std::is_nothrow_copy_constructible<std_alloc_ring_buffer<ftl_test::trivial_type>>::value);
             CHECK(std::is_nothrow_move_constructible<std_alloc_ring_buffer<ftl_test::trivial_type>>::value);
-            CHECK(std::is_nothrow_copy_assignable<std_alloc_ring_buffer<ftl_test::trivial_type>>::value);
             CHECK(std::is_nothrow_move_assignable<std_alloc_ring_buffer<ftl_test::trivial_type>>::value);
+
+            // copying allocates
+            CHECK(std::is_copy_constructible<std_alloc_ring_buffer<ftl_test::trivial_type>>::value);
+            CHECK(std::is_copy_assignable<std_alloc_ring_buffer<ftl_test::trivial_type>>::value);
         }
 
-        SUBCASE("ring buffer is trivially assignable") {
-            CHECK(std::is_trivially_copy_assignable<std_alloc_ring_buffer<ftl_test::trivial_type>>::value);
-            CHECK(std::is_trivially_move_assignable<std_alloc_ring_buffer<ftl_test::trivial_type>>::value);
+        SUBCASE("ring buffer is nothrow swappable") {
+            CHECK(std::is_nothrow_swappable<std_alloc_ring_buffer<ftl_test::trivial_type>>::value);
+            CHECK(std::is_nothrow_swappable<std_alloc_ring_buffer<ftl_test::nontrivial_type>>::value);
         }
     }
 
@@ -176,6 +180,261 @@ TEST_SUITE("ftl::ring buffer with allocator") {
         }
     }
 
+    TEST_CASE("copy / move / swap") {
+        SUBCASE("Copy owns its own storage") {
+            std_alloc_ring_buffer<std::string> original;
+            original.push(std::string("a"));
+            original.push(std::string("b"));
+
+            std_alloc_ring_buffer<std::string> copy = original;
+            CHECK(copy.size() == 2);
+            CHECK(copy.capacity() == original.capacity());
+            CHECK(&copy.front() != &original.front());
+
+            copy.front() += "c";
+            CHECK(copy.front() == "ac");
+            CHECK(original.front() == "a");
+        }
+
+        SUBCASE("Move takes over the allocation") {
+            std_alloc_ring_buffer<int> original;
+            for (int i = 0; i < 10; ++i)
+                original.push(i);
+
+            const int* storage = &original.front();
+            std_alloc_ring_buffer<int> moved = FTL_MOVE(original);
+            CHECK(&moved.front() == storage);
+            CHECK(moved.size() == 10);
+            CHECK(original.is_empty());
+
+            std_alloc_ring_buffer<int> assigned;
+            assigned.push(42);
+            assigned = FTL_MOVE(moved);
+            CHECK(&assigned.front() == storage);
+            CHECK(assigned.back() == 9);
+        }
+
+        SUBCASE("Swap exchanges allocations") {
+            std_alloc_ring_buffer<int> a, b;
+            a.push(1);
+            b.push(2);
+            b.push(3);
+
+            const int* a_storage = &a.front();
+            swap(a, b);
+            CHECK(a.size() == 2);
+            CHECK(&b.front() == a_storage);
+            CHECK(b.front() == 1);
+        }
+
+        SUBCASE("Copying a wrapped buffer keeps the order") {
+            std_alloc_ring_buffer<int> original;
+            original.push(0);
+            const int cap = static_cast<int>(original.capacity());
+            for (int i = 1; i < cap + 3; ++i)
+                original.push_overwrite(i);
+
+            std_alloc_ring_buffer<int> copy;
+            copy.push(-1);
+            copy = original;
+
+            REQUIRE(copy.size() == original.size());
+            int expected = 3;
+            for (int i : copy)
+                CHECK(i == expected++);
+        }
+    }
+
+    TEST_CASE("growing") {
+        SUBCASE("Pushing to a full buffer grows it and keeps the order") {
+            std_alloc_ring_buffer<int> test_buf;
+            test_buf.push(0);
+            int a = test_buf.pop(); (void)a;
+
+            for (int i = 0; i < 100; ++i)
+                test_buf.push(i);
+
+            CHECK(test_buf.size() == 100);
+            for (int i = 0; i < 100; ++i)
+                CHECK(test_buf.pop() == i);
+        }
+
+        SUBCASE("Every element is destroyed exactly once") {
+            using counter_type = ftl_test::counted_ctr_dtr<"arb-grow-0">;
+            {
+                std_alloc_ring_buffer<counter_type> test_buf;
+                for (int i = 0; i < 20; ++i)
+                    test_buf.push(counter_type{});
+            }
+            CHECK(counter_type::destroyed == counter_type::default_constructed + counter_type::move_constructed + counter_type::copy_constructed);
+        }
+    }
+
+    TEST_CASE("growth policies") {
+        SUBCASE("Default policy starts at 8 and doubles") {
+            ftl::geometric_growth<> policy;
+            CHECK(policy(0, 1, sizeof(int)) == 8);
+            CHECK(policy(8, 9, sizeof(int)) == 16);
+            CHECK(policy(8, 40, sizeof(int)) == 40);
+        }
+
+        SUBCASE("1.5x growth") {
+            ftl::geometric_growth<4, 3, 2> policy;
+            CHECK(policy(0, 1, 1) == 4);
+            CHECK(policy(4, 5, 1) == 6);
+            CHECK(policy(6, 7, 1) == 9);
+            CHECK(policy(1, 2, 1) == 2);
+        }
+
+        SUBCASE("Power of two rounding") {
+            ftl::geometric_growth<5, 3, 2, ftl::round_to_power_of_two> policy;
+            CHECK(policy(0, 1, 1) == 8);
+            CHECK(policy(8, 9, 1) == 16);
+            CHECK(policy(16, 100, 1) == 128);
+        }
+
+        SUBCASE("Page rounding fills whole pages") {
+            ftl::geometric_growth<8, 2, 1, ftl::round_to_pages<>> policy;
+            CHECK(policy(0, 1, sizeof(int)) == 1024);
+            CHECK(policy(1024, 1025, sizeof(int)) == 2048);
+            CHECK(policy(0, 1, 24) == 170);
+
+            ftl::geometric_growth<8, 2, 1, ftl::round_to_pages<2 << 20>> huge;
+            CHECK(huge(0, 1, 64) == (2 << 20) / 64);
+        }
+
+        SUBCASE("Maximum capacity is not exceeded") {
+            ftl::geometric_growth<8, 2, 1, ftl::round_to_power_of_two, 20> policy;
+            CHECK(policy(8, 9, 1) == 16);
+            CHECK(policy(16, 17, 1) == 20);
+            CHECK(policy(20, 21, 1) == 20);
+        }
+
+        SUBCASE("Buffer uses its growth policy") {
+            struct policy : ftl::default_ring_buffer_policy {
+                using growth_policy = ftl::geometric_growth<3, 3, 2>;
+            };
+            ftl::ring_buffer<int, std::allocator<int>, policy> test_buf;
+
+            test_buf.push(0);
+            CHECK(test_buf.capacity() == 3);
+            for (int i = 1; i < 4; ++i)
+                test_buf.push(i);
+            CHECK(test_buf.capacity() == 4);
+            test_buf.push(4);
+            CHECK(test_buf.capacity() == 6);
+
+            for (int i = 0; i < 5; ++i)
+                CHECK(test_buf.pop() == i);
+        }
+
+        SUBCASE("Buffer at maximum capacity behaves as static") {
+            struct policy : ftl::default_ring_buffer_policy {
+                using growth_policy = ftl::geometric_growth<4, 2, 1, ftl::exact_capacity, 8>;
+            };
+            ftl::ring_buffer<int, std::allocator<int>, policy> test_buf;
+
+            for (int i = 0; i < 8; ++i)
+                test_buf.push(i);
+            CHECK(test_buf.capacity() == 8);
+            CHECK(test_buf.is_full());
+            CHECK_THROWS(test_buf.push(8));
+
+            test_buf.push_overwrite(8);
+            CHECK(test_buf.front() == 1);
+            CHECK(test_buf.back() == 8);
+
+            std_alloc_ring_buffer<int> src;
+            for (int i = 0; i < 4; ++i)
+                src.push(i);
+            (void)test_buf.pop();
+            CHECK(test_buf.transfer_from(src, 4) == 1);
+            CHECK(src.size() == 3);
+        }
+    }
+
+    TEST_CASE("shrinking") {
+        SUBCASE("shrink_to_fit() reallocates to the size and keeps the order") {
+            std_alloc_ring_buffer<std::string> test_buf;
+            for (int i = 0; i < 40; ++i)
+                test_buf.push(std::to_string(i));
+            for (int i = 0; i < 35; ++i)
+                (void)test_buf.pop();
+
+            test_buf.shrink_to_fit();
+            CHECK(test_buf.capacity() == 5);
+            CHECK(test_buf.is_full());
+            for (int i = 35; i < 40; ++i)
+                CHECK(test_buf.pop() == std::to_string(i));
+
+            test_buf.shrink_to_fit();
+            CHECK(test_buf.capacity() == 0);
+
+            test_buf.push("again");
+            CHECK(test_buf.front() == "again");
+        }
+
+        SUBCASE("Default policy never shrinks") {
+            std_alloc_ring_buffer<int> test_buf;
+            for (int i = 0; i < 64; ++i)
+                test_buf.push(i);
+            for (int i = 0; i < 1000; ++i) {
+                (void)test_buf.pop();
+                test_buf.push(i);
+                if (test_buf.size() > 1)
+                    (void)test_buf.pop();
+            }
+            CHECK(test_buf.capacity() == 64);
+        }
+
+        SUBCASE("Hysteresis policy halves capacity after a quiet period") {
+            struct policy : ftl::default_ring_buffer_policy {
+                using shrink_policy = ftl::hysteresis_shrink<25, 16>;
+            };
+            ftl::ring_buffer<int, std::allocator<int>, policy> test_buf;
+
+            for (int i = 0; i < 64; ++i)
+                test_buf.push(i);
+
+            // the pop at 16 elements is not under 25 %, the next 14 are
+            for (int i = 0; i < 63; ++i)
+                CHECK(test_buf.pop() == i);
+            CHECK(test_buf.capacity() == 64);
+
+            test_buf.push(64);
+            CHECK(test_buf.capacity() == 64);
+            test_buf.push(65);
+            CHECK(test_buf.capacity() == 32);
+            CHECK(test_buf.pop() == 63);
+
+            int next = 66, expected = 64;
+
+            for (int i = 0; i < 200; ++i) {
+                test_buf.push(next++);
+                CHECK(test_buf.pop() == expected++);
+            }
+            CHECK(test_buf.capacity() == 8);
+            CHECK(test_buf.size() == 2);
+        }
+    }
+
+    TEST_CASE("transfer_from() steals the storage of the source when possible") {
+        std_alloc_ring_buffer<std::string> src, dst;
+        for (int i = 0; i < 10; ++i)
+            src.push(std::to_string(i));
+
+        const std::string* first = &src.front();
+        CHECK(dst.transfer_from(src, src.size()) == 10);
+        CHECK(&dst.front() == first);
+        CHECK(src.is_empty());
+        CHECK(dst.back() == "9");
+
+        // partial transfer has to move the elements
+        CHECK(src.transfer_from(dst, 3) == 3);
+        CHECK(src.front() == "0");
+        CHECK(dst.front() == "3");
+    }
+
     TEST_CASE("Pushing / popping move-only types") {
         using move_counter = ftl_test::move_only_counter<"arb-move-counter-0">;
         std_alloc_ring_buffer<move_counter> test_buf;
@@ -224,6 +224,104 @@ TEST_SUITE("ring buffer common functionality") {
         }
     }
 
+    TEST_CASE_TEMPLATE("segments", T, static_ring_buffer<int>, std_alloc_ring_buffer<int>) {
+        SUBCASE("Empty buffer has no segments") {
+            T test_buffer;
+            CHECK(test_buffer.segments().empty());
+        }
+
+        SUBCASE("Wrapped contents are split in two segments in order") {
+            T test_buffer;
+            test_buffer.push(0);
+            const int cap = static_cast<int>(test_buffer.capacity());
+            for (int i = 1; i < cap + 3; ++i)
+                test_buffer.push_overwrite(i);
+
+            auto seg = test_buffer.segments();
+            CHECK(seg.size() == test_buffer.size());
+            CHECK(seg.second.size() == 3);
+
+            int expected = 3;
+            for (int i : seg.first)
+                CHECK(i == expected++);
+            for (int i : seg.second)
+                CHECK(i == expected++);
+        }
+    }
+
+    TEST_CASE_TEMPLATE("transfer_from()", T, static_ring_buffer<int>, std_alloc_ring_buffer<int>) {
+        SUBCASE("Moves the oldest elements in order") {
+            T src, dst;
+            for (int i = 0; i < 10; ++i)
+                src.push(i);
+            dst.push(-1);
+
+            CHECK(dst.transfer_from(src, 4) == 4);
+            CHECK(src.size() == 6);
+            CHECK(dst.size() == 5);
+            CHECK(src.front() == 4);
+
+            int expected = -1;
+            for (int i : dst) {
+                CHECK(i == expected);
+                expected = expected == -1 ? 0 : expected + 1;
+            }
+        }
+
+        SUBCASE("Wrapped source and destination") {
+            T src, dst;
+            src.push(0);
+            dst.push(0);
+            const int cap = static_cast<int>(src.capacity());
+            for (int i = 1; i < cap + cap / 2; ++i) {
+                src.push_overwrite(i);
+                dst.push_overwrite(i);
+            }
+            for (int i = 0; i < cap / 2 + 1; ++i) {
+                int a = dst.pop(); (void)a;
+            }
+            REQUIRE(not src.is_contiguous());
+
+            const std::size_t old_dst_size = dst.size();
+            const int first_moved = src.front();
+            const std::size_t moved = dst.transfer_from(src, src.size());
+
+            CHECK(dst.size() == old_dst_size + moved);
+            for (std::size_t i = 0; i < moved; ++i)
+                CHECK(dst.segments()[old_dst_size + i] == first_moved + static_cast<int>(i));
+        }
+
+        SUBCASE("Transferring more than available moves everything") {
+            T src, dst;
+            src.push(1);
+            src.push(2);
+
+            CHECK(dst.transfer_from(src, 100) == 2);
+            CHECK(src.is_empty());
+            CHECK(dst.pop() == 1);
+            CHECK(dst.pop() == 2);
+        }
+    }
+
+    TEST_CASE("transfer_from() between storage types") {
+        static_ring_buffer<int> src;
+        std_alloc_ring_buffer<int> dst;
+        for (int i = 0; i < 16; ++i)
+            src.push(i);
+
+        CHECK(dst.transfer_from(src, 16) == 16);
+        CHECK(src.is_empty());
+        CHECK(dst.front() == 0);
+        CHECK(dst.back() == 15);
+
+        // static destination only takes what fits
+        static_ring_buffer<int> small;
+        small.push(0);
+        CHECK(small.transfer_from(dst, 16) == 15);
+        CHECK(small.is_full());
+        CHECK(dst.size() == 1);
+    }
+
     TEST_CASE_TEMPLATE("iterators", T, static_ring_buffer<int>, std_alloc_ring_buffer<int>) {
         SUBCASE("Range-based for") {
             T test_buffer;
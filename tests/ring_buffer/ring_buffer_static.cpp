@@ -2,6 +2,8 @@
 #include "../test_common.hpp"
 #include <type_traits>
 #include <string>
+#include <cstdint>
+#include <stdexcept>
 #include <ftl/ring_buffer.hpp>
 
 template <typename T>
@@ -17,11 +19,8 @@ TEST_SUITE("ftl::ring buffer with static_storage") {
             CHECK(std::is_nothrow_move_assignable<static_ring_buffer<int>>::value);
         }
 
-        SUBCASE("triviality") {
-            CHECK(std::is_trivially_copy_constructible<static_ring_buffer<int>>::value);
-            CHECK(std::is_trivially_move_constructible<static_ring_buffer<int>>::value);
-            CHECK(std::is_trivially_copy_assignable<static_ring_buffer<int>>::value);
-            CHECK(std::is_trivially_move_assignable<static_ring_buffer<int>>::value);
+        SUBCASE("ring buffer is nothrow swappable") {
+            CHECK(std::is_nothrow_swappable<static_ring_buffer<int>>::value);
         }
     }
 
@@ -34,11 +33,21 @@ TEST_SUITE("ftl::ring buffer with static_storage") {
             CHECK(std::is_nothrow_move_assignable<static_ring_buffer<ftl_test::trivial_type>>::value);
         }
 
-        SUBCASE("ring buffer is trivially copyable / movable") {
-            CHECK(std::is_trivially_copy_constructible<static_ring_buffer<ftl_test::trivial_type>>::value);
-            CHECK(std::is_trivially_move_constructible<static_ring_buffer<ftl_test::trivial_type>>::value);
-            CHECK(std::is_trivially_copy_assignable<static_ring_buffer<ftl_test::trivial_type>>::value);
-            CHECK(std::is_trivially_move_assignable<static_ring_buffer<ftl_test::trivial_type>>::value);
+        // the heads point into the buffer itself, so a bytewise copy would alias the original
+        SUBCASE("copies do not alias the original") {
+            static_ring_buffer<int> original;
+            original.push(1);
+            original.push(2);
+
+            static_ring_buffer<int> copy = original;
+            CHECK(&copy.front() != &original.front());
+            copy.front() = 3;
+            CHECK(original.front() == 1);
+
+            static_ring_buffer<int> assigned;
+            assigned = original;
+            CHECK(&assigned.back() != &original.back());
+            CHECK(assigned.back() == 2);
         }
     }
 
@@ -71,6 +80,180 @@ TEST_SUITE("ftl::ring buffer with static_storage") {
         REQUIRE(sizeof(test_buf_s8) > sizeof(std::string) * 8);
     }
 
+    TEST_CASE("watermarks") {
+        struct event_log {
+            int highs = 0, lows = 0;
+            std::size_t dropped = 0;
+        };
+        static event_log log;
+        log = {};
+
+        struct callback {
+            void operator()(ftl::ring_buffer_event event, std::size_t value) const {
+                if (event == ftl::ring_buffer_event::high_watermark) ++log.highs;
+                if (event == ftl::ring_buffer_event::low_watermark) ++log.lows;
+                if (event == ftl::ring_buffer_event::overwrite) log.dropped += value;
+            }
+        };
+        struct policy : ftl::default_ring_buffer_policy {
+            using observer = ftl::watermark_observer<callback>;
+        };
+        ftl::ring_buffer<int, ftl::static_storage<8>, policy> test_buf;
+        test_buf.get_observer().set_watermarks(2, 6);
+
+        SUBCASE("Crossings fire once and toggle the flag") {
+            for (int i = 0; i < 5; ++i)
+                test_buf.push(i);
+            CHECK(not test_buf.get_observer().is_throttled());
+
+            test_buf.push(5);
+            CHECK(test_buf.get_observer().is_throttled());
+            CHECK(log.highs == 1);
+
+            // between the marks nothing changes
+            (void)test_buf.pop();
+            test_buf.push(6);
+            test_buf.push(7);
+            CHECK(log.highs == 1);
+            CHECK(log.lows == 0);
+
+            while (test_buf.size() > 3)
+                (void)test_buf.pop();
+            CHECK(test_buf.get_observer().is_throttled());
+
+            (void)test_buf.pop();
+            CHECK(not test_buf.get_observer().is_throttled());
+            CHECK(log.lows == 1);
+        }
+
+        SUBCASE("clear() and transfer_from() count as crossings") {
+            for (int i = 0; i < 6; ++i)
+                test_buf.push(i);
+            test_buf.clear();
+            CHECK(log.highs == 1);
+            CHECK(log.lows == 1);
+
+            ftl::ring_buffer<int, ftl::static_storage<8>> src;
+            for (int i = 0; i < 7; ++i)
+                src.push(i);
+            CHECK(test_buf.transfer_from(src, 7) == 7);
+            CHECK(log.highs == 2);
+        }
+
+        SUBCASE("Overwrites report dropped elements") {
+            for (int i = 0; i < 8; ++i)
+                test_buf.push_overwrite(i);
+            CHECK(log.dropped == 0);
+
+            for (int i = 8; i < 11; ++i)
+                test_buf.push_overwrite(i);
+            CHECK(log.dropped == 3);
+            CHECK(test_buf.get_observer().dropped() == 3);
+            CHECK(test_buf.front() == 3);
+        }
+
+        SUBCASE("Observer goes with the contents") {
+            for (int i = 0; i < 6; ++i)
+                test_buf.push(i);
+
+            auto moved = FTL_MOVE(test_buf);
+            CHECK(moved.get_observer().is_throttled());
+            CHECK(moved.get_observer().high_watermark() == 6);
+            CHECK(log.highs == 1);
+        }
+    }
+
+    TEST_CASE("watermark callback may be empty") {
+        using callback = void(*)(ftl::ring_buffer_event, std::size_t);
+        struct policy : ftl::default_ring_buffer_policy {
+            using observer = ftl::watermark_observer<callback>;
+        };
+        ftl::ring_buffer<int, ftl::static_storage<4>, policy> test_buf;
+        test_buf.get_observer().set_watermarks(0, 2);
+
+        for (int i = 0; i < 6; ++i)
+            test_buf.push_overwrite(i);
+        CHECK(test_buf.get_observer().is_throttled());
+        CHECK(test_buf.get_observer().dropped() == 2);
+    }
+
+    TEST_CASE("throwing watermark callbacks propagate") {
+        struct callback {
+            void operator()(ftl::ring_buffer_event, std::size_t) const { throw std::runtime_error("callback"); }
+        };
+        struct policy : ftl::default_ring_buffer_policy {
+            using observer = ftl::watermark_observer<callback>;
+        };
+        ftl::ring_buffer<int, ftl::static_storage<4>, policy> test_buf;
+        test_buf.get_observer().set_watermarks(0, 2);
+
+        CHECK_FALSE(noexcept(test_buf.clear()));
+        CHECK_FALSE(noexcept(test_buf.push_overwrite(1)));
+        CHECK(noexcept(static_ring_buffer<int>{}.clear()));
+
+        test_buf.push(1);
+        CHECK_THROWS_AS(test_buf.push(2), std::runtime_error);
+        CHECK(test_buf.size() == 2);
+        CHECK_THROWS_AS(test_buf.clear(), std::runtime_error);
+        CHECK(test_buf.is_empty());
+    }
+
+    TEST_CASE("move / swap") {
+        SUBCASE("Moving moves the elements and leaves the source empty") {
+            static_ring_buffer<std::string> original;
+            original.push(std::string("a"));
+            original.push(std::string("b"));
+
+            static_ring_buffer<std::string> moved = FTL_MOVE(original);
+            CHECK(moved.size() == 2);
+            CHECK(moved.back() == "b");
+            CHECK(original.is_empty());
+        }
+
+        SUBCASE("Swap exchanges contents") {
+            static_ring_buffer<int> a, b;
+            a.push(1);
+            b.push(2);
+            b.push(3);
+
+            a.swap(b);
+            CHECK(a.size() == 2);
+            CHECK(a.front() == 2);
+            CHECK(b.size() == 1);
+            CHECK(b.front() == 1);
+        }
+    }
+
+    TEST_CASE("aligned storage") {
+        using aligned_buffer = ftl::ring_buffer<char, ftl::static_storage<8, ftl::cache_line_size>>;
+
+        SUBCASE("Data starts on an aligned address") {
+            aligned_buffer test_buf[2];
+            test_buf[0].push('a');
+            test_buf[1].push('b');
+
+            CHECK(alignof(aligned_buffer) == ftl::cache_line_size);
+            CHECK(reinterpret_cast<std::uintptr_t>(&test_buf[0].front()) % ftl::cache_line_size == 0);
+            CHECK(reinterpret_cast<std::uintptr_t>(&test_buf[1].front()) % ftl::cache_line_size == 0);
+        }
+
+        SUBCASE("Data and both heads get a line of their own") {
+            CHECK(sizeof(aligned_buffer) == 3 * ftl::cache_line_size);
+            CHECK(sizeof(ftl::ring_buffer<int, ftl::static_storage<32, ftl::cache_line_size>>) == 4 * ftl::cache_line_size);
+        }
+
+        SUBCASE("Aligned buffer behaves like the packed one") {
+            aligned_buffer test_buf;
+            for (char c = 'a'; c < 'a' + 8; ++c)
+                test_buf.push(c);
+
+            CHECK(test_buf.is_full());
+            test_buf.push_overwrite('z');
+            CHECK(test_buf.front() == 'b');
+            CHECK(test_buf.back() == 'z');
+        }
+    }
+
     TEST_CASE("capacity and size") {
         SUBCASE("Capacity matches requested buffer size") {
             ftl::ring_buffer<int, ftl::static_storage<16>> test_buf_i16;
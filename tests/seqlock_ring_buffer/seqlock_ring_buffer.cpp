@@ -0,0 +1,128 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <ftl/seqlock_ring_buffer.hpp>
+
+namespace {
+    // fields that have to agree with each other, and a size that is not a
+    // multiple of the word size
+    struct sample
+    {
+        std::uint64_t   sequence;
+        std::uint64_t   inverse;
+        std::uint32_t   low;
+        std::uint8_t    tag;
+
+        static sample make(std::uint64_t n) {
+            return { n, ~n, static_cast<std::uint32_t>(n), static_cast<std::uint8_t>(n * 7) };
+        }
+
+        bool is_consistent() const {
+            return inverse == ~sequence && low == static_cast<std::uint32_t>(sequence) && tag == static_cast<std::uint8_t>(sequence * 7);
+        }
+    };
+}
+
+TEST_SUITE("ftl::seqlock_ring_buffer") {
+    TEST_CASE("Single-threaded reads") {
+        ftl::seqlock_ring_buffer<int, 4> buffer;
+        int out[4] = {};
+
+        SUBCASE("Empty buffer reads nothing") {
+            CHECK(buffer.size() == 0);
+            CHECK(buffer.read_latest(out, 4) == 0);
+            CHECK(not buffer.read_latest(out[0]));
+        }
+
+        SUBCASE("Newest elements are read oldest first") {
+            for (int i = 0; i < 3; ++i)
+                buffer.push(i);
+            CHECK(buffer.size() == 3);
+            REQUIRE(buffer.read_latest(out, 2) == 2);
+            CHECK(out[0] == 1);
+            CHECK(out[1] == 2);
+        }
+
+        SUBCASE("Writer overwrites the oldest element") {
+            for (int i = 0; i < 10; ++i)
+                buffer.push(i);
+            CHECK(buffer.size() == 4);
+            CHECK(buffer.pushed() == 10);
+            REQUIRE(buffer.read_latest(out, 100) == 4);
+            CHECK(out[0] == 6);
+            CHECK(out[3] == 9);
+
+            int latest = 0;
+            CHECK(buffer.read_latest(latest));
+            CHECK(latest == 9);
+        }
+
+        SUBCASE("Odd-sized elements survive the copy") {
+            ftl::seqlock_ring_buffer<sample, 3> samples;
+            for (std::uint64_t i = 0; i < 5; ++i)
+                samples.push(sample::make(i));
+
+            sample read[3];
+            REQUIRE(samples.read_latest(read, 3) == 3);
+            for (std::uint64_t i = 0; i < 3; ++i) {
+                CHECK(read[i].sequence == i + 2);
+                CHECK(read[i].is_consistent());
+            }
+        }
+    }
+
+    TEST_CASE("Readers see consistent windows while the writer runs") {
+        constexpr std::size_t capacity = 64;
+        constexpr std::uint64_t pushes = 200000;
+        ftl::seqlock_ring_buffer<sample, capacity> buffer;
+
+        std::atomic<bool> done { false };
+        std::atomic<int> torn { 0 };
+        std::atomic<int> out_of_order { 0 };
+        std::atomic<std::uint64_t> windows { 0 };
+
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&] {
+                sample window[capacity / 4];
+                std::uint64_t last_seen = 0;
+                // one more read after done, so every reader sees a window
+                // even if the writer finished before it was scheduled
+                for (bool finished = false; not finished;) {
+                    finished = done.load(std::memory_order_acquire);
+                    const std::size_t n = buffer.read_latest(window, capacity / 4);
+                    for (std::size_t i = 0; i < n; ++i) {
+                        if (not window[i].is_consistent())
+                            ++torn;
+                        if (i > 0 && window[i].sequence != window[i - 1].sequence + 1)
+                            ++out_of_order;
+                    }
+                    if (n > 0) {
+                        if (window[n - 1].sequence < last_seen)
+                            ++out_of_order;
+                        last_seen = window[n - 1].sequence;
+                        ++windows;
+                    }
+                }
+            });
+        }
+
+        for (std::uint64_t i = 0; i < pushes; ++i)
+            buffer.push(sample::make(i));
+        done.store(true, std::memory_order_release);
+
+        for (auto& reader : readers)
+            reader.join();
+
+        CHECK(torn == 0);
+        CHECK(out_of_order == 0);
+        CHECK(windows >= readers.size());
+
+        sample last;
+        REQUIRE(buffer.read_latest(last));
+        CHECK(last.sequence == pushes - 1);
+    }
+}
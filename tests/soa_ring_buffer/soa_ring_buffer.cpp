@@ -0,0 +1,157 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <cstdint>
+#include <string>
+#include <ftl/soa_ring_buffer.hpp>
+
+template <typename... Fields>
+using static_soa_ring_buffer = ftl::basic_soa_ring_buffer<ftl::static_storage<8>, Fields...>;
+
+template <typename... Fields>
+using std_alloc_soa_ring_buffer = ftl::basic_soa_ring_buffer<std::allocator<unsigned char>, Fields...>;
+
+TYPE_TO_STRING(static_soa_ring_buffer<std::uint64_t, double, int>);
+TYPE_TO_STRING(std_alloc_soa_ring_buffer<std::uint64_t, double, int>);
+
+TEST_SUITE("ftl::soa_ring_buffer") {
+    TEST_CASE_TEMPLATE("Pushing / popping elements", T, static_soa_ring_buffer<std::uint64_t, double, int>,
+                                                       std_alloc_soa_ring_buffer<std::uint64_t, double, int>) {
+        SUBCASE("Push and pop keep fields together in order") {
+            T test_buf;
+            test_buf.push(1u, 1.5, 10);
+            test_buf.push(2u, 2.5, 20);
+            REQUIRE(test_buf.size() == 2);
+
+            auto [ts, price, qty] = test_buf.pop();
+            CHECK(ts == 1);
+            CHECK(price == 1.5);
+            CHECK(qty == 10);
+            CHECK(test_buf.size() == 1);
+            CHECK(test_buf.template front<2>() == 20);
+        }
+
+        SUBCASE("push_overwrite drops the oldest element") {
+            T test_buf;
+            test_buf.push(0u, 0.0, 0);
+            const int cap = static_cast<int>(test_buf.capacity());
+            for (int i = 1; i < cap; ++i)
+                test_buf.push(static_cast<std::uint64_t>(i), i * 1.0, i);
+            REQUIRE(test_buf.is_full());
+
+            test_buf.push_overwrite(100u, 100.0, 100);
+            CHECK(test_buf.capacity() == static_cast<std::size_t>(cap));
+            CHECK(test_buf.template front<0>() == 1);
+            CHECK(test_buf.template back<1>() == 100.0);
+            CHECK(not test_buf.is_contiguous());
+        }
+
+        SUBCASE("Column segments cover the contents in order") {
+            T test_buf;
+            test_buf.push(0u, 0.0, 0);
+            const int cap = static_cast<int>(test_buf.capacity());
+            for (int i = 1; i < cap + cap / 2; ++i)
+                test_buf.push_overwrite(static_cast<std::uint64_t>(i), i * 1.0, i);
+
+            auto qty = test_buf.template column<2>();
+            REQUIRE(qty.size() == test_buf.size());
+            CHECK(not qty.second.empty());
+
+            int expected = cap / 2;
+            for (int v : qty.first)
+                CHECK(v == expected++);
+            for (int v : qty.second)
+                CHECK(v == expected++);
+
+            // segments are writable and share the element order with get()
+            qty[0] = -1;
+            CHECK(test_buf.template get<2>(0) == -1);
+        }
+    }
+
+    TEST_CASE("Allocator-backed buffer grows") {
+        std_alloc_soa_ring_buffer<int, std::string> test_buf;
+        CHECK(test_buf.capacity() == 0);
+
+        for (int i = 0; i < 100; ++i)
+            test_buf.push(i, std::to_string(i));
+
+        CHECK(test_buf.size() == 100);
+        CHECK(test_buf.capacity() >= 100);
+
+        for (int i = 0; i < 100; ++i) {
+            auto [n, str] = test_buf.pop();
+            CHECK(n == i);
+            CHECK(str == std::to_string(i));
+        }
+    }
+
+    TEST_CASE("Static buffer throws when full") {
+        static_soa_ring_buffer<int, float> test_buf;
+        for (int i = 0; i < 8; ++i)
+            test_buf.push(i, 0.0f);
+
+        CHECK_THROWS_AS(test_buf.push(8, 0.0f), std::out_of_range);
+    }
+
+    TEST_CASE("Columns do not interleave") {
+        static_soa_ring_buffer<std::uint64_t, std::uint8_t> test_buf;
+        test_buf.push(1u, std::uint8_t{2});
+        test_buf.push(3u, std::uint8_t{4});
+
+        auto wide = test_buf.column<0>();
+        auto narrow = test_buf.column<1>();
+        CHECK(wide.first.data() + 1 == &test_buf.get<0>(1));
+        CHECK(narrow.first.data() + 1 == &test_buf.get<1>(1));
+    }
+
+    TEST_CASE("Copying and moving") {
+        std_alloc_soa_ring_buffer<int, std::string> original;
+        original.push(1, std::string("one"));
+        original.push(2, std::string("two"));
+
+        auto copy = original;
+        CHECK(copy.size() == 2);
+        CHECK(copy.get<1>(1) == "two");
+        CHECK(original.get<1>(1) == "two");
+
+        auto moved = FTL_MOVE(copy);
+        CHECK(moved.size() == 2);
+        CHECK(moved.get<1>(0) == "one");
+        CHECK(copy.size() == 0);
+
+        static_soa_ring_buffer<int, std::string> static_original;
+        static_original.push(1, std::string("one"));
+        auto static_copy = static_original;
+        CHECK(static_copy.get<1>(0) == "one");
+    }
+
+    TEST_CASE("Destructors of fields are called") {
+        using counter_type = ftl_test::counted_ctr_dtr<"soa-dtr-0">;
+        {
+            std_alloc_soa_ring_buffer<int, counter_type> test_buf;
+            for (int i = 0; i < 20; ++i)
+                test_buf.push(i, counter_type{});
+            test_buf.discard(5);
+        }
+        CHECK(counter_type::destroyed == counter_type::default_constructed + counter_type::move_constructed + counter_type::copy_constructed);
+    }
+}
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
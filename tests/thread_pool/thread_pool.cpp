@@ -0,0 +1,120 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include <ftl/thread_pool.hpp>
+
+TEST_SUITE("ftl::thread_pool") {
+    TEST_CASE("submitting tasks") {
+        SUBCASE("All submitted tasks run before the pool is destroyed") {
+            std::atomic<int> counter = 0;
+            {
+                ftl::thread_pool pool(4);
+                for (int i = 0; i < 10000; ++i)
+                    pool.submit([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+            }
+            CHECK(counter.load() == 10000);
+        }
+
+        SUBCASE("Tasks can submit more tasks") {
+            std::atomic<int> counter = 0;
+            {
+                ftl::thread_pool pool(4);
+                for (int i = 0; i < 100; ++i) {
+                    pool.submit([&pool, &counter] {
+                        for (int j = 0; j < 100; ++j)
+                            pool.submit([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+                    });
+                }
+            }
+            CHECK(counter.load() == 10000);
+        }
+
+        SUBCASE("Zero threads is rounded up to one") {
+            ftl::thread_pool pool(0);
+            CHECK(pool.size() == 1);
+        }
+
+        SUBCASE("Calling thread is not a worker") {
+            ftl::thread_pool pool(2);
+            std::atomic<int> inside = 0;
+            CHECK(not pool.is_worker_thread());
+            ftl::parallel_for(pool, 0, 1, [&](int) { inside = pool.is_worker_thread() ? 1 : -1; });
+            CHECK(inside == 1);
+        }
+    }
+
+    TEST_CASE("parallel_for") {
+        SUBCASE("Every index is visited exactly once") {
+            ftl::thread_pool pool(4);
+            std::vector<std::atomic<int>> visited(100000);
+
+            ftl::parallel_for(pool, 0, 100000, [&](int i) { visited[i].fetch_add(1, std::memory_order_relaxed); });
+
+            bool all_once = true;
+            for (auto& v : visited)
+                all_once = all_once && v.load() == 1;
+            CHECK(all_once);
+        }
+
+        SUBCASE("Explicit grain size and non-zero start") {
+            ftl::thread_pool pool(3);
+            std::atomic<long> sum = 0;
+
+            ftl::parallel_for(pool, 10l, 1010l, [&](long i) { sum.fetch_add(i, std::memory_order_relaxed); }, 7l);
+            CHECK(sum.load() == (10 + 1009) * 1000 / 2);
+        }
+
+        SUBCASE("Empty range does nothing") {
+            ftl::thread_pool pool(2);
+            int calls = 0;
+            ftl::parallel_for(pool, 5, 5, [&](int) { ++calls; });
+            ftl::parallel_for(pool, 5, 2, [&](int) { ++calls; });
+            CHECK(calls == 0);
+        }
+
+        SUBCASE("Nested parallel_for from inside the pool does not deadlock") {
+            ftl::thread_pool pool(2);
+            std::atomic<int> counter = 0;
+
+            ftl::parallel_for(pool, 0, 8, [&](int) {
+                ftl::parallel_for(pool, 0, 100, [&](int) { counter.fetch_add(1, std::memory_order_relaxed); });
+            }, 1);
+
+            CHECK(counter.load() == 800);
+        }
+
+        SUBCASE("Exceptions are rethrown to the caller") {
+            ftl::thread_pool pool(4);
+            CHECK_THROWS_AS(ftl::parallel_for(pool, 0, 1000, [](int i) {
+                if (i == 500)
+                    throw std::runtime_error("fail");
+            }), std::runtime_error);
+
+            // pool stays usable afterwards
+            std::atomic<int> counter = 0;
+            ftl::parallel_for(pool, 0, 100, [&](int) { counter.fetch_add(1); });
+            CHECK(counter.load() == 100);
+        }
+    }
+}
+/*
+    Copyright 2022 Jari Ronkainen
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+    associated documentation files (the "Software"), to deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+    of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or substantial portions
+    of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+    LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+    OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
@@ -0,0 +1,102 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <cstdint>
+#include <string>
+#include <ftl/timeseries_ring.hpp>
+
+template <typename T>
+using static_timeseries_ring = ftl::timeseries_ring<T, std::uint64_t, ftl::static_storage<8>>;
+
+template <typename T>
+using std_alloc_timeseries_ring = ftl::timeseries_ring<T, std::uint64_t, std::allocator<unsigned char>>;
+
+TYPE_TO_STRING(static_timeseries_ring<int>);
+TYPE_TO_STRING(std_alloc_timeseries_ring<int>);
+
+namespace {
+    template <typename Range>
+    std::string values_of(const Range& range) {
+        std::string result;
+        for (std::size_t i = 0; i < range.size(); ++i)
+            result += std::to_string(range.values[i]) + " ";
+        return result;
+    }
+}
+
+TEST_SUITE("ftl::timeseries_ring") {
+    TEST_CASE_TEMPLATE("Range queries", T, static_timeseries_ring<int>, std_alloc_timeseries_ring<int>) {
+        T series;
+        for (int i = 0; i < 6; ++i)
+            series.push(static_cast<std::uint64_t>(i * 10), i);
+
+        SUBCASE("since() includes samples at the given time") {
+            CHECK(values_of(series.since(20)) == "2 3 4 5 ");
+            CHECK(values_of(series.since(21)) == "3 4 5 ");
+            CHECK(values_of(series.since(0)) == "0 1 2 3 4 5 ");
+            CHECK(series.since(51).empty());
+        }
+
+        SUBCASE("between() is half-open") {
+            CHECK(values_of(series.between(10, 40)) == "1 2 3 ");
+            CHECK(values_of(series.between(5, 41)) == "1 2 3 4 ");
+            CHECK(series.between(40, 10).empty());
+            CHECK(series.between(11, 20).empty());
+        }
+
+        SUBCASE("Timestamps and values are split at the same index") {
+            auto range = series.between(10, 40);
+            REQUIRE(range.times.size() == 3);
+            CHECK(range.times[0] == 10);
+            CHECK(range.times[2] == 30);
+            CHECK(range.values.size() == 3);
+        }
+
+        SUBCASE("Equal timestamps are allowed") {
+            series.push(50u, 6);
+            series.push(50u, 7);
+            CHECK(values_of(series.since(50)) == "5 6 7 ");
+            CHECK(series.lower_bound(50) == 5);
+        }
+    }
+
+    TEST_CASE("Queries over wrapped storage") {
+        static_timeseries_ring<int> series;
+        for (int i = 0; i < 13; ++i)
+            series.push_overwrite(static_cast<std::uint64_t>(i * 10), i);
+
+        REQUIRE(series.size() == 8);
+        CHECK(series.oldest() == 50);
+        CHECK(series.latest() == 120);
+
+        // every split point between and inside the two segments
+        for (std::uint64_t t = 40; t <= 130; t += 5) {
+            std::string expected;
+            for (int i = 5; i < 13; ++i)
+                if (static_cast<std::uint64_t>(i * 10) >= t)
+                    expected += std::to_string(i) + " ";
+            CHECK(values_of(series.since(t)) == expected);
+        }
+
+        auto range = series.between(60, 110);
+        CHECK(values_of(range) == "6 7 8 9 10 ");
+        CHECK(range.times.first.size() + range.times.second.size() == 5);
+    }
+
+    TEST_CASE_TEMPLATE("Time-based eviction", T, static_timeseries_ring<std::string>, std_alloc_timeseries_ring<std::string>) {
+        T series;
+        for (int i = 0; i < 6; ++i)
+            series.push(static_cast<std::uint64_t>(i * 10), std::to_string(i));
+
+        CHECK(series.evict_before(25) == 3);
+        CHECK(series.size() == 3);
+        CHECK(series.oldest() == 30);
+        CHECK(series.value(0) == "3");
+
+        CHECK(series.evict_before(0) == 0);
+        CHECK(series.evict_before(1000) == 3);
+        CHECK(series.is_empty());
+
+        series.push(100u, "again");
+        CHECK(series.value(0) == "again");
+    }
+}
@@ -0,0 +1,111 @@
+#include "../doctest.h"
+#include "../test_common.hpp"
+#include <sstream>
+#include <string>
+#include <thread>
+#include <ftl/trace.hpp>
+
+namespace {
+    std::size_t count_of(const std::string& haystack, const std::string& needle) {
+        std::size_t count = 0;
+        for (std::size_t pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1))
+            ++count;
+        return count;
+    }
+
+    std::string dump() {
+        std::ostringstream out;
+        ftl::trace_dump_chrome_json(out);
+        return out.str();
+    }
+}
+
+TEST_SUITE("ftl::trace") {
+    TEST_CASE("Interning returns stable ids") {
+        const std::uint32_t a = ftl::trace_intern("trace-test-a");
+        const std::uint32_t b = ftl::trace_intern("trace-test-b");
+        CHECK(a != b);
+        CHECK(ftl::trace_intern("trace-test-a") == a);
+    }
+
+    TEST_CASE("Events are dumped as Chrome trace JSON") {
+        ftl::trace_clear();
+        const std::uint32_t work = ftl::trace_intern("work");
+        const std::uint32_t queue = ftl::trace_intern("queue depth");
+
+        {
+            ftl::trace_scope scope(work, 7);
+            ftl::trace_counter(queue, 42);
+        }
+        ftl::trace_instant(ftl::trace_intern("say \"hi\"\n"), 3);
+
+        const std::string json = dump();
+        CHECK(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) == 0);
+        CHECK(json.find("\n]}") != std::string::npos);
+
+        CHECK(count_of(json, "\"name\":\"work\",\"ph\":\"B\"") == 1);
+        CHECK(count_of(json, "\"name\":\"work\",\"ph\":\"E\"") == 1);
+        CHECK(count_of(json, "\"args\":{\"payload\":7}") == 1);
+        CHECK(count_of(json, "\"ph\":\"C\"") == 1);
+        CHECK(count_of(json, "\"args\":{\"value\":42}") == 1);
+        CHECK(count_of(json, "\"name\":\"say \\\"hi\\\"\\u000a\",\"ph\":\"i\"") == 1);
+    }
+
+    TEST_CASE("Timestamps are in order and in microseconds") {
+        ftl::trace_clear();
+        const std::uint32_t tick = ftl::trace_intern("tick");
+
+        ftl::trace_instant(tick);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ftl::trace_instant(tick);
+
+        const std::string json = dump();
+        const std::size_t first = json.find("\"ts\":");
+        const std::size_t second = json.find("\"ts\":", first + 1);
+        REQUIRE(second != std::string::npos);
+
+        const double t0 = std::stod(json.substr(first + 5));
+        const double t1 = std::stod(json.substr(second + 5));
+        CHECK(t1 - t0 > 15000.0);
+        CHECK(t1 - t0 < 1000000.0);
+    }
+
+    TEST_CASE("Each thread keeps its own last events") {
+        ftl::trace_clear();
+        ftl::trace_set_capacity(16);
+        const std::uint32_t spin = ftl::trace_intern("spin");
+
+        std::thread a([&] { for (int i = 0; i < 100; ++i) ftl::trace_instant(spin, i); });
+        std::thread b([&] { for (int i = 0; i < 5; ++i) ftl::trace_instant(spin, i); });
+        a.join();
+        b.join();
+
+        // buffers of exited threads are kept until cleared
+        const std::string json = dump();
+        CHECK(count_of(json, "\"name\":\"spin\"") == 21);
+        CHECK(count_of(json, "\"args\":{\"payload\":99}") == 1);
+        CHECK(count_of(json, "\"args\":{\"payload\":83}") == 0);
+
+        ftl::trace_clear();
+        CHECK(count_of(dump(), "\"name\":\"spin\"") == 0);
+        ftl::trace_set_capacity(4096);
+    }
+
+    TEST_CASE("Dumping while other threads record") {
+        ftl::trace_clear();
+        const std::uint32_t busy = ftl::trace_intern("busy");
+        std::atomic<bool> stop { false };
+
+        std::thread writer([&] {
+            std::uint64_t i = 0;
+            while (not stop.load(std::memory_order_relaxed))
+                ftl::trace_instant(busy, i++);
+        });
+
+        for (int i = 0; i < 20; ++i)
+            CHECK(dump().find("\n]}") != std::string::npos);
+
+        stop = true;
+        writer.join();
+    }
+}